@@ -25,17 +25,40 @@
 #include "nodegl.h"
 #include "nodes.h"
 
+static double get_kf_time(struct ngl_node * const *animkf, int id)
+{
+    const struct animkeyframe_priv *kf = animkf[id]->priv_data;
+    return kf->time;
+}
+
+/*
+ * Return the index of the last keyframe with a time lower or equal to t, or -1
+ * if t is before the first keyframe.
+ */
 static int get_kf_id(struct ngl_node * const *animkf, int nb_animkf, int start, double t)
 {
-    int ret = -1;
+    int lo = 0;
+    int hi = nb_animkf;
+
+    if (start < nb_animkf && get_kf_time(animkf, start) <= t) {
+        /* Fast path for sequential playback: t is still within the current
+         * keyframe interval or has moved to the next one */
+        if (start + 1 >= nb_animkf || get_kf_time(animkf, start + 1) > t)
+            return start;
+        if (start + 2 >= nb_animkf || get_kf_time(animkf, start + 2) > t)
+            return start + 1;
+        lo = start + 2;
+    }
 
-    for (int i = start; i < nb_animkf; i++) {
-        const struct animkeyframe_priv *kf = animkf[i]->priv_data;
-        if (kf->time > t)
-            break;
-        ret = i;
+    /* Bisection on the remaining keyframes (forward or backward seek) */
+    while (lo < hi) {
+        const int mid = lo + (hi - lo) / 2;
+        if (get_kf_time(animkf, mid) > t)
+            hi = mid;
+        else
+            lo = mid + 1;
     }
-    return ret;
+    return lo - 1;
 }
 
 int ngli_animation_evaluate(struct animation *s, void *dst, double t)
@@ -44,9 +67,7 @@ int ngli_animation_evaluate(struct animation *s, void *dst, double t)
     const int nb_animkf = s->nb_kfs;
     if (!nb_animkf)
         return 0;
-    int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
-    if (kf_id < 0)
-        kf_id = get_kf_id(animkf, nb_animkf, 0, t);
+    const int kf_id = get_kf_id(animkf, nb_animkf, s->current_kf, t);
     if (kf_id >= 0 && kf_id < nb_animkf - 1) {
         const struct animkeyframe_priv *kf0 = animkf[kf_id    ]->priv_data;
         const struct animkeyframe_priv *kf1 = animkf[kf_id + 1]->priv_data;
@@ -156,6 +156,10 @@ static int cmd_set_scene(struct ngl_ctx *s, void *arg)
         ngl_node_unrefp(&s->scene);
     }
 
+    /* Attachments released by the previous scene are unlikely to match the
+     * ones of the new scene */
+    ngli_texture_pool_flush(s);
+
     struct ngl_node *scene = arg;
     if (!scene)
         return 0;
@@ -233,6 +237,9 @@ static int cmd_stop(struct ngl_ctx *s, void *arg)
 static int dispatch_cmd(struct ngl_ctx *s, cmd_func_type cmd_func, void *arg)
 {
     pthread_mutex_lock(&s->lock);
+    /* Pending asynchronous draws must be honored before any other command */
+    while (s->nb_queued_draws)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
     s->cmd_func = cmd_func;
     s->cmd_arg = arg;
     pthread_cond_signal(&s->cond_wkr);
@@ -251,8 +258,24 @@ static void *worker_thread(void *arg)
 
     pthread_mutex_lock(&s->lock);
     for (;;) {
-        while (!s->cmd_func)
+        while (!s->cmd_func && !s->nb_queued_draws)
             pthread_cond_wait(&s->cond_wkr, &s->lock);
+
+        if (s->nb_queued_draws) {
+            /* The lock is released while drawing so the controller can keep
+             * queuing frames (or doing its own work) in the meantime */
+            double t = s->draw_queue[s->draw_queue_pos];
+            pthread_mutex_unlock(&s->lock);
+            int ret = cmd_draw(s, &t);
+            pthread_mutex_lock(&s->lock);
+            s->draw_queue_pos = (s->draw_queue_pos + 1) % NGLI_ARRAY_NB(s->draw_queue);
+            s->nb_queued_draws--;
+            if (ret < 0 && !s->draw_ret)
+                s->draw_ret = ret;
+            pthread_cond_signal(&s->cond_ctl);
+            continue;
+        }
+
         s->cmd_ret = s->cmd_func(s, s->cmd_arg);
         int need_stop = s->cmd_func == cmd_stop;
         s->cmd_func = s->cmd_arg = NULL;
@@ -331,6 +354,7 @@ struct ngl_ctx *ngl_create(void)
     ngli_darray_init(&s->modelview_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->projection_matrix_stack, 4 * 4 * sizeof(float), 1);
     ngli_darray_init(&s->activitycheck_nodes, sizeof(struct ngl_node *), 0);
+    ngli_darray_init(&s->texture_pool, sizeof(struct texture), 0);
 
     static const NGLI_ALIGNED_MAT(id_matrix) = NGLI_MAT4_IDENTITY;
     if (!ngli_darray_push(&s->modelview_matrix_stack, id_matrix) ||
@@ -369,6 +393,11 @@ int ngl_configure(struct ngl_ctx *s, struct ngl_config *config)
         }
     }
 
+    if (config->capture_latency < 0) {
+        LOG(ERROR, "capture latency cannot be negative (%d)", config->capture_latency);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
     if (s->configured) {
         s->configured = 0;
 #if defined(TARGET_IPHONE) || defined(TARGET_DARWIN)
@@ -423,6 +452,54 @@ int ngl_draw(struct ngl_ctx *s, double t)
     return dispatch_cmd(s, cmd_draw, &t);
 }
 
+int ngl_draw_async(struct ngl_ctx *s, double t)
+{
+    if (!s->configured) {
+        LOG(ERROR, "context must be configured before drawing");
+        return NGL_ERROR_INVALID_USAGE;
+    }
+
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued_draws == NGLI_ARRAY_NB(s->draw_queue))
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    int ret = s->draw_ret;
+    if (ret < 0) {
+        s->draw_ret = 0;
+    } else {
+        const int pos = (s->draw_queue_pos + s->nb_queued_draws) % NGLI_ARRAY_NB(s->draw_queue);
+        s->draw_queue[pos] = t;
+        s->nb_queued_draws++;
+        pthread_cond_signal(&s->cond_wkr);
+    }
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
+/*
+ * Unlike ngl_wait(), the error of a failed draw is preserved so it can still
+ * be reported to the user by the next ngl_draw_async() or ngl_wait() call.
+ */
+void ngli_wait_queued_draws(struct ngl_ctx *s)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued_draws)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    pthread_mutex_unlock(&s->lock);
+}
+
+int ngl_wait(struct ngl_ctx *s)
+{
+    pthread_mutex_lock(&s->lock);
+    while (s->nb_queued_draws)
+        pthread_cond_wait(&s->cond_ctl, &s->lock);
+    int ret = s->draw_ret;
+    s->draw_ret = 0;
+    pthread_mutex_unlock(&s->lock);
+
+    return ret;
+}
+
 void ngl_freep(struct ngl_ctx **ss)
 {
     struct ngl_ctx *s = *ss;
@@ -437,6 +514,7 @@ void ngl_freep(struct ngl_ctx **ss)
     ngli_darray_reset(&s->modelview_matrix_stack);
     ngli_darray_reset(&s->projection_matrix_stack);
     ngli_darray_reset(&s->activitycheck_nodes);
+    ngli_darray_reset(&s->texture_pool);
     ngli_free(*ss);
     *ss = NULL;
 }
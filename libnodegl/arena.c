@@ -0,0 +1,117 @@
+/*
+ * Copyright 2019 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "arena.h"
+#include "memory.h"
+#include "utils.h"
+
+struct arena_chunk {
+    size_t size; // usable size, after the chunk header
+    size_t pos;
+    int refcount;
+};
+
+/* Both headers are padded so that every allocation is aligned on NGLI_ALIGN_VAL */
+#define CHUNK_HEADER_SIZE NGLI_ALIGN(sizeof(struct arena_chunk), NGLI_ALIGN_VAL)
+#define ALLOC_HEADER_SIZE NGLI_ALIGN(sizeof(struct arena_chunk *), NGLI_ALIGN_VAL)
+
+void ngli_arena_init(struct arena *arena, size_t chunk_size)
+{
+    memset(arena, 0, sizeof(*arena));
+    arena->chunk_size = chunk_size;
+}
+
+static struct arena_chunk *chunk_create(size_t size)
+{
+    struct arena_chunk *chunk = ngli_malloc_aligned(CHUNK_HEADER_SIZE + size);
+    if (!chunk)
+        return NULL;
+    chunk->size = size;
+    chunk->pos = 0;
+    chunk->refcount = 0;
+    return chunk;
+}
+
+static void *chunk_alloc(struct arena_chunk *chunk, size_t size)
+{
+    uint8_t *hdr = (uint8_t *)chunk + CHUNK_HEADER_SIZE + chunk->pos;
+    memcpy(hdr, &chunk, sizeof(chunk));
+    chunk->pos += ALLOC_HEADER_SIZE + size;
+    chunk->refcount++;
+    uint8_t *ptr = hdr + ALLOC_HEADER_SIZE;
+    memset(ptr, 0, size);
+    return ptr;
+}
+
+void *ngli_arena_alloc(struct arena *arena, size_t size)
+{
+    size = NGLI_ALIGN(size, NGLI_ALIGN_VAL);
+    const size_t needed = ALLOC_HEADER_SIZE + size;
+
+    /* Allocations too large for a chunk get a dedicated one, which is
+     * released along with the allocation */
+    if (needed > arena->chunk_size) {
+        struct arena_chunk *chunk = chunk_create(needed);
+        if (!chunk)
+            return NULL;
+        return chunk_alloc(chunk, size);
+    }
+
+    struct arena_chunk *cur = arena->cur;
+    if (!cur || cur->pos + needed > cur->size) {
+        struct arena_chunk *chunk = chunk_create(arena->chunk_size);
+        if (!chunk)
+            return NULL;
+        /* The previous chunk is now released by its last allocation */
+        if (cur && !cur->refcount)
+            ngli_free_aligned(cur);
+        arena->cur = cur = chunk;
+    }
+    return chunk_alloc(cur, size);
+}
+
+void ngli_arena_free(struct arena *arena, void *ptr)
+{
+    if (!ptr)
+        return;
+
+    struct arena_chunk *chunk;
+    memcpy(&chunk, (uint8_t *)ptr - ALLOC_HEADER_SIZE, sizeof(chunk));
+    ngli_assert(chunk->refcount > 0);
+    if (--chunk->refcount)
+        return;
+
+    if (chunk == arena->cur)
+        chunk->pos = 0;
+    else
+        ngli_free_aligned(chunk);
+}
+
+void ngli_arena_reset(struct arena *arena)
+{
+    struct arena_chunk *cur = arena->cur;
+    if (cur && !cur->refcount)
+        ngli_free_aligned(cur);
+    arena->cur = NULL;
+}
@@ -0,0 +1,47 @@
+/*
+ * Copyright 2019 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#ifndef ARENA_H
+#define ARENA_H
+
+#include <stddef.h>
+
+struct arena_chunk;
+
+/*
+ * Chunked bump allocator: allocations are carved out of large chunks, which
+ * keeps objects allocated together contiguous in memory and makes most
+ * allocations a pointer increment. Each allocation can be released
+ * individually with ngli_arena_free(); a chunk is given back to the system
+ * once all its allocations are released (or recycled if it is still the
+ * current one). The arena is not thread-safe.
+ */
+struct arena {
+    size_t chunk_size;
+    struct arena_chunk *cur;
+};
+
+void ngli_arena_init(struct arena *arena, size_t chunk_size);
+void *ngli_arena_alloc(struct arena *arena, size_t size);
+void ngli_arena_free(struct arena *arena, void *ptr);
+void ngli_arena_reset(struct arena *arena);
+
+#endif
@@ -0,0 +1,84 @@
+/*
+ * Copyright 2019 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <xmmintrin.h>
+
+#include "math_utils.h"
+
+/*
+ * SSE is part of the x86-64 baseline so these functions do not need any
+ * runtime detection. Loads and stores are unaligned since not every caller
+ * uses NGLI_ALIGNED_MAT/NGLI_ALIGNED_VEC storage. The destination may alias
+ * any of the sources: all the inputs are read before anything is stored.
+ */
+
+static inline __m128 mul_col(__m128 c0, __m128 c1, __m128 c2, __m128 c3, const float *v)
+{
+    __m128 r = _mm_mul_ps(c0, _mm_set1_ps(v[0]));
+    r = _mm_add_ps(r, _mm_mul_ps(c1, _mm_set1_ps(v[1])));
+    r = _mm_add_ps(r, _mm_mul_ps(c2, _mm_set1_ps(v[2])));
+    r = _mm_add_ps(r, _mm_mul_ps(c3, _mm_set1_ps(v[3])));
+    return r;
+}
+
+void ngli_mat4_mul_x86_64(float *dst, const float *m1, const float *m2)
+{
+    const __m128 c0 = _mm_loadu_ps(m1);
+    const __m128 c1 = _mm_loadu_ps(m1 + 4);
+    const __m128 c2 = _mm_loadu_ps(m1 + 8);
+    const __m128 c3 = _mm_loadu_ps(m1 + 12);
+
+    const __m128 r0 = mul_col(c0, c1, c2, c3, m2);
+    const __m128 r1 = mul_col(c0, c1, c2, c3, m2 + 4);
+    const __m128 r2 = mul_col(c0, c1, c2, c3, m2 + 8);
+    const __m128 r3 = mul_col(c0, c1, c2, c3, m2 + 12);
+
+    _mm_storeu_ps(dst,      r0);
+    _mm_storeu_ps(dst + 4,  r1);
+    _mm_storeu_ps(dst + 8,  r2);
+    _mm_storeu_ps(dst + 12, r3);
+}
+
+void ngli_mat4_mul_vec4_x86_64(float *dst, const float *m, const float *v)
+{
+    const __m128 c0 = _mm_loadu_ps(m);
+    const __m128 c1 = _mm_loadu_ps(m + 4);
+    const __m128 c2 = _mm_loadu_ps(m + 8);
+    const __m128 c3 = _mm_loadu_ps(m + 12);
+
+    _mm_storeu_ps(dst, mul_col(c0, c1, c2, c3, v));
+}
+
+void ngli_mix_floats_x86_64(float *dst, const float *v1, const float *v2, float c, int n)
+{
+    const float d = 1.f - c;
+    const __m128 vc = _mm_set1_ps(c);
+    const __m128 vd = _mm_set1_ps(d);
+
+    int i = 0;
+    for (; i + 4 <= n; i += 4) {
+        const __m128 a = _mm_mul_ps(_mm_loadu_ps(v1 + i), vd);
+        const __m128 b = _mm_mul_ps(_mm_loadu_ps(v2 + i), vc);
+        _mm_storeu_ps(dst + i, _mm_add_ps(a, b));
+    }
+    for (; i < n; i++)
+        dst[i] = v1[i]*d + v2[i]*c;
+}
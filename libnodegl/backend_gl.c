@@ -98,6 +98,48 @@ static void capture_default(struct ngl_ctx *s)
     ngli_rendertarget_read_pixels(capture_rt, config->capture_buffer);
 }
 
+static void read_pixels_async(struct ngl_ctx *s)
+{
+    struct glcontext *gl = s->glcontext;
+    struct ngl_config *config = &s->config;
+    struct rendertarget *capture_rt = &s->capture_rt;
+
+    const int index = s->capture_pbo_index;
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, s->capture_pbos[index]);
+    ngli_rendertarget_read_pixels(capture_rt, NULL);
+    s->capture_fences[index] = ngli_glFenceSync(gl, GL_SYNC_GPU_COMMANDS_COMPLETE, 0);
+    s->capture_pbo_index = (index + 1) % s->nb_capture_pbos;
+
+    /* The next slot in the ring holds the oldest pending read back, issued
+     * capture_latency frames ago, which is likely already completed */
+    const int oldest = s->capture_pbo_index;
+    GLsync fence = s->capture_fences[oldest];
+    if (fence) {
+        ngli_glClientWaitSync(gl, fence, GL_SYNC_FLUSH_COMMANDS_BIT, GL_TIMEOUT_IGNORED);
+        ngli_glDeleteSync(gl, fence);
+        s->capture_fences[oldest] = NULL;
+
+        const int size = config->width * config->height * 4;
+        ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, s->capture_pbos[oldest]);
+        const uint8_t *data = ngli_glMapBufferRange(gl, GL_PIXEL_PACK_BUFFER, 0, size, GL_MAP_READ_BIT);
+        if (data) {
+            memcpy(config->capture_buffer, data, size);
+            ngli_glUnmapBuffer(gl, GL_PIXEL_PACK_BUFFER);
+        }
+    }
+
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+}
+
+static void capture_default_async(struct ngl_ctx *s)
+{
+    struct rendertarget *rt = &s->rt;
+    struct rendertarget *capture_rt = &s->capture_rt;
+
+    ngli_rendertarget_blit(rt, capture_rt, 1);
+    read_pixels_async(s);
+}
+
 static void capture_ios(struct ngl_ctx *s)
 {
     struct glcontext *gl = s->glcontext;
@@ -120,6 +162,17 @@ static void capture_gles_msaa(struct ngl_ctx *s)
     ngli_rendertarget_read_pixels(capture_rt, config->capture_buffer);
 }
 
+static void capture_gles_msaa_async(struct ngl_ctx *s)
+{
+    struct rendertarget *rt = &s->rt;
+    struct rendertarget *capture_rt = &s->capture_rt;
+    struct rendertarget *oes_resolve_rt = &s->oes_resolve_rt;
+
+    ngli_rendertarget_blit(rt, oes_resolve_rt, 0);
+    ngli_rendertarget_blit(oes_resolve_rt, capture_rt, 1);
+    read_pixels_async(s);
+}
+
 static void capture_ios_msaa(struct ngl_ctx *s)
 {
     struct glcontext *gl = s->glcontext;
@@ -148,6 +201,37 @@ static void capture_cpu_fallback(struct ngl_ctx *s)
     }
 }
 
+static int capture_async_init(struct ngl_ctx *s)
+{
+    struct glcontext *gl = s->glcontext;
+    struct ngl_config *config = &s->config;
+
+    const int features = NGLI_FEATURE_SYNC | NGLI_FEATURE_MAP_BUFFER_RANGE;
+    if ((gl->features & features) != features) {
+        LOG(WARNING, "context does not support sync objects and buffer mapping, "
+            "capture will be synchronous");
+        return 0;
+    }
+
+    const int nb_pbos = config->capture_latency + 1;
+    s->capture_pbos = ngli_calloc(nb_pbos, sizeof(*s->capture_pbos));
+    s->capture_fences = ngli_calloc(nb_pbos, sizeof(*s->capture_fences));
+    if (!s->capture_pbos || !s->capture_fences)
+        return NGL_ERROR_MEMORY;
+
+    const int size = config->width * config->height * 4;
+    ngli_glGenBuffers(gl, nb_pbos, s->capture_pbos);
+    for (int i = 0; i < nb_pbos; i++) {
+        ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, s->capture_pbos[i]);
+        ngli_glBufferData(gl, GL_PIXEL_PACK_BUFFER, size, NULL, GL_STREAM_READ);
+    }
+    ngli_glBindBuffer(gl, GL_PIXEL_PACK_BUFFER, 0);
+    s->nb_capture_pbos = nb_pbos;
+    s->capture_pbo_index = 0;
+
+    return 1;
+}
+
 static int capture_init(struct ngl_ctx *s)
 {
     struct glcontext *gl = s->glcontext;
@@ -190,6 +274,7 @@ static int capture_init(struct ngl_ctx *s)
             ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
             ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
             ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+            ngli_gctx_invalidate_active_texture(s);
 
             struct texture_params attachment_params = NGLI_TEXTURE_PARAM_DEFAULTS;
             attachment_params.format = NGLI_FORMAT_B8G8R8A8_UNORM;
@@ -251,6 +336,15 @@ static int capture_init(struct ngl_ctx *s)
             s->capture_func = config->capture_buffer ? capture_default : capture_ios;
         }
 
+        if (config->capture_buffer && config->capture_latency > 0) {
+            ret = capture_async_init(s);
+            if (ret < 0)
+                return ret;
+            if (ret)
+                s->capture_func = s->capture_func == capture_gles_msaa ? capture_gles_msaa_async
+                                                                       : capture_default_async;
+        }
+
     } else {
         if (ios_capture) {
             LOG(WARNING, "context does not support the framebuffer object feature, "
@@ -271,6 +365,20 @@ static int capture_init(struct ngl_ctx *s)
 
 static void capture_reset(struct ngl_ctx *s)
 {
+    struct glcontext *gl = s->glcontext;
+
+    for (int i = 0; i < s->nb_capture_pbos; i++) {
+        if (s->capture_fences[i])
+            ngli_glDeleteSync(gl, s->capture_fences[i]);
+    }
+    if (s->nb_capture_pbos)
+        ngli_glDeleteBuffers(gl, s->nb_capture_pbos, s->capture_pbos);
+    ngli_free(s->capture_pbos);
+    s->capture_pbos = NULL;
+    ngli_free(s->capture_fences);
+    s->capture_fences = NULL;
+    s->nb_capture_pbos = 0;
+    s->capture_pbo_index = 0;
     ngli_rendertarget_reset(&s->capture_rt);
     ngli_texture_reset(&s->capture_rt_color);
     ngli_rendertarget_reset(&s->oes_resolve_rt);
@@ -283,6 +391,7 @@ static void capture_reset(struct ngl_ctx *s)
         s->capture_cvbuffer = NULL;
     }
     if (s->capture_cvtexture) {
+        ngli_gctx_invalidate_texture(s, CVOpenGLESTextureGetName(s->capture_cvtexture));
         CFRelease(s->capture_cvtexture);
         s->capture_cvtexture = NULL;
     }
@@ -305,8 +414,10 @@ static int gl_reconfigure(struct ngl_ctx *s, const struct ngl_config *config)
     current_config->width = config->width;
     current_config->height = config->height;
 
-    const int update_capture = !current_config->capture_buffer != !config->capture_buffer;
+    const int update_capture = !current_config->capture_buffer != !config->capture_buffer ||
+                               current_config->capture_latency != config->capture_latency;
     current_config->capture_buffer = config->capture_buffer;
+    current_config->capture_latency = config->capture_latency;
 
     if (config->offscreen) {
         if (update_dimensions) {
@@ -368,6 +479,18 @@ static int gl_configure(struct ngl_ctx *s, const struct ngl_config *config)
 
     ngli_glstate_probe(s->glcontext, &s->glstate);
 
+    /* Programs are shared between nodes using identical shader sources; the
+     * cache is tied to the GL context lifetime */
+    s->program_cache = ngli_program_cache_create();
+    if (!s->program_cache)
+        return NGL_ERROR_MEMORY;
+
+    /* Last pipeline having uploaded uniforms to each program, indexed by GL
+     * program id (see claim_program_uniforms() in pipeline.c) */
+    s->program_uniforms_owners = ngli_hmap_create_u64();
+    if (!s->program_uniforms_owners)
+        return NGL_ERROR_MEMORY;
+
     /* This field is used by the pipeline API in order to reduce the total
      * number of GL program switches. This means pipeline draw calls may alter
      * this value, but we don't want it to be hard-reconfigure resilient (the
@@ -375,6 +498,10 @@ static int gl_configure(struct ngl_ctx *s, const struct ngl_config *config)
      * sure the value is always reset. */
     s->program_id = 0;
 
+    /* Same as above for the texture units bindings */
+    ngli_gctx_reset_texture_bindings(s);
+    s->pending_barriers = 0;
+
     const int *viewport = config->viewport;
     if (viewport[2] > 0 && viewport[3] > 0) {
         ngli_gctx_set_viewport(s, viewport);
@@ -414,6 +541,7 @@ static int gl_post_draw(struct ngl_ctx *s, double t)
     struct ngl_config *config = &s->config;
 
     ngli_honor_pending_glstate(s);
+    ngli_gctx_flush_memory_barriers(s);
 
     if (s->capture_func)
         s->capture_func(s);
@@ -437,6 +565,9 @@ static void gl_destroy(struct ngl_ctx *s)
 #if defined(HAVE_VAAPI_X11)
     ngli_vaapi_reset(s);
 #endif
+    ngli_program_cache_freep(&s->program_cache);
+    ngli_hmap_freep(&s->program_uniforms_owners);
+    ngli_texture_pool_flush(s);
     ngli_glcontext_freep(&s->glcontext);
 }
 
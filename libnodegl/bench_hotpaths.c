@@ -0,0 +1,438 @@
+/*
+ * Copyright 2019 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <inttypes.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "darray.h"
+#include "glcontext.h"
+#include "hmap.h"
+#include "math_utils.h"
+#include "memory.h"
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+/*
+ * Each benchmark runs a fixed number of operations; it is repeated a few
+ * times and the fastest run is reported, which filters out most of the
+ * scheduling noise.
+ */
+#define NB_RUNS 5
+
+struct bench {
+    const char *name;
+    int nb_ops;
+    int (*init)(void **ctxp);
+    int (*run)(void *ctx, int nb_ops);
+    void (*uninit)(void **ctxp);
+};
+
+#define NB_KEYS 100000
+
+struct hmap_ctx {
+    struct hmap *hm_str;
+    struct hmap *hm_u64;
+    char (*str_keys)[16];
+};
+
+static int hmap_init(void **ctxp, int fill)
+{
+    struct hmap_ctx *c = ngli_calloc(1, sizeof(*c));
+    if (!c)
+        return NGL_ERROR_MEMORY;
+    *ctxp = c;
+    c->str_keys = ngli_calloc(NB_KEYS, sizeof(*c->str_keys));
+    if (!c->str_keys)
+        return NGL_ERROR_MEMORY;
+    for (int i = 0; i < NB_KEYS; i++)
+        snprintf(c->str_keys[i], sizeof(c->str_keys[i]), "key%d", i);
+    if (!fill)
+        return 0;
+    c->hm_str = ngli_hmap_create();
+    c->hm_u64 = ngli_hmap_create_u64();
+    if (!c->hm_str || !c->hm_u64)
+        return NGL_ERROR_MEMORY;
+    for (int i = 0; i < NB_KEYS; i++) {
+        int ret;
+        if ((ret = ngli_hmap_set(c->hm_str, c->str_keys[i], c)) < 0 ||
+            (ret = ngli_hmap_set_u64(c->hm_u64, i, c)) < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static int hmap_empty_init(void **ctxp) { return hmap_init(ctxp, 0); }
+static int hmap_filled_init(void **ctxp) { return hmap_init(ctxp, 1); }
+
+static void hmap_uninit(void **ctxp)
+{
+    struct hmap_ctx *c = *ctxp;
+    if (!c)
+        return;
+    ngli_hmap_freep(&c->hm_str);
+    ngli_hmap_freep(&c->hm_u64);
+    ngli_free(c->str_keys);
+    ngli_free(c);
+    *ctxp = NULL;
+}
+
+static int hmap_str_set_run(void *ctx, int nb_ops)
+{
+    struct hmap_ctx *c = ctx;
+    struct hmap *hm = ngli_hmap_create();
+    if (!hm)
+        return NGL_ERROR_MEMORY;
+    for (int i = 0; i < nb_ops; i++) {
+        int ret = ngli_hmap_set(hm, c->str_keys[i % NB_KEYS], c);
+        if (ret < 0) {
+            ngli_hmap_freep(&hm);
+            return ret;
+        }
+    }
+    ngli_hmap_freep(&hm);
+    return 0;
+}
+
+static int hmap_str_get_run(void *ctx, int nb_ops)
+{
+    struct hmap_ctx *c = ctx;
+    for (int i = 0; i < nb_ops; i++)
+        if (!ngli_hmap_get(c->hm_str, c->str_keys[(int)((i * 7919LL) % NB_KEYS)]))
+            return NGL_ERROR_BUG;
+    return 0;
+}
+
+static int hmap_u64_set_run(void *ctx, int nb_ops)
+{
+    struct hmap *hm = ngli_hmap_create_u64();
+    if (!hm)
+        return NGL_ERROR_MEMORY;
+    for (int i = 0; i < nb_ops; i++) {
+        int ret = ngli_hmap_set_u64(hm, (uintptr_t)&hm + i * 64, hm);
+        if (ret < 0) {
+            ngli_hmap_freep(&hm);
+            return ret;
+        }
+    }
+    ngli_hmap_freep(&hm);
+    return 0;
+}
+
+static int hmap_u64_get_run(void *ctx, int nb_ops)
+{
+    struct hmap_ctx *c = ctx;
+    for (int i = 0; i < nb_ops; i++)
+        if (!ngli_hmap_get_u64(c->hm_u64, (int)((i * 7919LL) % NB_KEYS)))
+            return NGL_ERROR_BUG;
+    return 0;
+}
+
+static int darray_push_run(void *ctx, int nb_ops)
+{
+    struct darray darray;
+    ngli_darray_init(&darray, sizeof(int), 0);
+    for (int i = 0; i < nb_ops; i++) {
+        if (!ngli_darray_push(&darray, &i)) {
+            ngli_darray_reset(&darray);
+            return NGL_ERROR_MEMORY;
+        }
+    }
+    ngli_darray_reset(&darray);
+    return 0;
+}
+
+static const NGLI_ALIGNED_MAT(bench_mat) = {
+    0.99f, 0.01f, 0.00f, 0.00f,
+   -0.01f, 0.99f, 0.00f, 0.00f,
+    0.00f, 0.00f, 1.00f, 0.00f,
+    0.10f, 0.20f, 0.30f, 1.00f,
+};
+
+/* The operands are constant so that the values neither overflow nor reach
+ * denormals, which would skew the timings */
+static int mat4_mul_run(void *ctx, int nb_ops)
+{
+    static const NGLI_ALIGNED_MAT(id) = NGLI_MAT4_IDENTITY;
+    NGLI_ALIGNED_MAT(m);
+    for (int i = 0; i < nb_ops; i++)
+        ngli_mat4_mul(m, id, bench_mat);
+    return m[0] == 42.f; // keep the result alive
+}
+
+static int mat4_mul_vec4_run(void *ctx, int nb_ops)
+{
+    static const NGLI_ALIGNED_VEC(v) = {1.f, 2.f, 3.f, 1.f};
+    NGLI_ALIGNED_VEC(r);
+    for (int i = 0; i < nb_ops; i++)
+        ngli_mat4_mul_vec4(r, bench_mat, v);
+    return r[0] == 42.f;
+}
+
+#define NB_KEYFRAMES 100
+
+static int anim_init(void **ctxp)
+{
+    struct ngl_node *kfs[NB_KEYFRAMES] = {0};
+    struct ngl_node *anim = ngl_node_create(NGL_NODE_ANIMATEDFLOAT);
+    if (!anim)
+        return NGL_ERROR_MEMORY;
+    *ctxp = anim;
+    for (int i = 0; i < NB_KEYFRAMES; i++) {
+        kfs[i] = ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT, (double)i, (double)(i & 1));
+        if (!kfs[i])
+            return NGL_ERROR_MEMORY;
+        if (i)
+            ngl_node_param_set(kfs[i], "easing", "quadratic_in_out");
+        int ret = ngl_node_param_add(anim, "keyframes", 1, &kfs[i]);
+        ngl_node_unrefp(&kfs[i]);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static void node_uninit(void **ctxp)
+{
+    ngl_node_unrefp((struct ngl_node **)ctxp);
+}
+
+static int anim_evaluate_run(void *ctx, int nb_ops)
+{
+    float v;
+    for (int i = 0; i < nb_ops; i++) {
+        const double t = ((i * 7919LL) % (NB_KEYFRAMES * 100)) / 100.;
+        int ret = ngl_anim_evaluate(ctx, &v, t);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+#define NB_BLOCK_FIELDS 16
+
+/* Block nodes only need the context for the GL features check */
+static struct glcontext bench_gl = {
+    .features = NGLI_FEATURE_UNIFORM_BUFFER_OBJECT | NGLI_FEATURE_SHADER_STORAGE_BUFFER_OBJECT,
+};
+static struct ngl_ctx bench_ctx = {.glcontext = &bench_gl};
+
+static int block_init(void **ctxp)
+{
+    struct ngl_node *block = ngl_node_create(NGL_NODE_BLOCK);
+    if (!block)
+        return NGL_ERROR_MEMORY;
+    *ctxp = block;
+    static const int field_types[] = {
+        NGL_NODE_UNIFORMFLOAT, NGL_NODE_UNIFORMVEC3, NGL_NODE_UNIFORMVEC2, NGL_NODE_UNIFORMMAT4,
+    };
+    for (int i = 0; i < NB_BLOCK_FIELDS; i++) {
+        struct ngl_node *field = ngl_node_create(field_types[i % NGLI_ARRAY_NB(field_types)]);
+        if (!field)
+            return NGL_ERROR_MEMORY;
+        int ret = ngl_node_param_add(block, "fields", 1, &field);
+        ngl_node_unrefp(&field);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
+
+static int block_layout_run(void *ctx, int nb_ops)
+{
+    for (int i = 0; i < nb_ops; i++) {
+        int ret = ngli_node_attach_ctx(ctx, &bench_ctx);
+        if (ret < 0)
+            return ret;
+        ngli_node_detach_ctx(ctx, &bench_ctx);
+    }
+    return 0;
+}
+
+#define NB_SCENE_RENDERS 64
+#define SCENE_BUFFER_SIZE 4096
+
+struct scene_ctx {
+    struct ngl_node *scene;
+    char *text;
+    void *bin;
+    int bin_size;
+};
+
+static int scene_init(void **ctxp)
+{
+    struct scene_ctx *c = ngli_calloc(1, sizeof(*c));
+    if (!c)
+        return NGL_ERROR_MEMORY;
+    *ctxp = c;
+
+    float *data = ngli_calloc(SCENE_BUFFER_SIZE, sizeof(*data));
+    c->scene = ngl_node_create(NGL_NODE_GROUP);
+    struct ngl_node *quad = ngl_node_create(NGL_NODE_QUAD);
+    struct ngl_node *program = ngl_node_create(NGL_NODE_PROGRAM);
+    int ret = data && c->scene && quad && program ? 0 : NGL_ERROR_MEMORY;
+    for (int i = 0; i < NB_SCENE_RENDERS && ret >= 0; i++) {
+        for (int j = 0; j < SCENE_BUFFER_SIZE; j++)
+            data[j] = i * j * .5f;
+        struct ngl_node *buffer = ngl_node_create(NGL_NODE_BUFFERFLOAT);
+        struct ngl_node *render = ngl_node_create(NGL_NODE_RENDER, quad);
+        struct ngl_node *tr = ngl_node_create(NGL_NODE_TRANSLATE, render);
+        if (!buffer || !render || !tr)
+            ret = NGL_ERROR_MEMORY;
+        if (ret >= 0)
+            ret = ngl_node_param_set(buffer, "data", SCENE_BUFFER_SIZE * (int)sizeof(*data), data);
+        if (ret >= 0)
+            ret = ngl_node_param_set(render, "program", program);
+        if (ret >= 0)
+            ret = ngl_node_param_set(render, "attributes", "values", buffer);
+        if (ret >= 0)
+            ret = ngl_node_param_set(tr, "vector", (float[3]){i, i * 2.f, 0.f});
+        if (ret >= 0)
+            ret = ngl_node_param_add(c->scene, "children", 1, &tr);
+        ngl_node_unrefp(&buffer);
+        ngl_node_unrefp(&render);
+        ngl_node_unrefp(&tr);
+    }
+    ngl_node_unrefp(&quad);
+    ngl_node_unrefp(&program);
+    ngli_free(data);
+    if (ret < 0)
+        return ret;
+
+    c->text = ngl_node_serialize(c->scene);
+    c->bin = ngl_node_serialize_binary(c->scene, &c->bin_size);
+    if (!c->text || !c->bin)
+        return NGL_ERROR_MEMORY;
+    return 0;
+}
+
+static void scene_uninit(void **ctxp)
+{
+    struct scene_ctx *c = *ctxp;
+    if (!c)
+        return;
+    ngl_node_unrefp(&c->scene);
+    free(c->text);
+    free(c->bin);
+    ngli_free(c);
+    *ctxp = NULL;
+}
+
+static int serialize_text_run(void *ctx, int nb_ops)
+{
+    struct scene_ctx *c = ctx;
+    for (int i = 0; i < nb_ops; i++) {
+        char *s = ngl_node_serialize(c->scene);
+        if (!s)
+            return NGL_ERROR_MEMORY;
+        free(s);
+    }
+    return 0;
+}
+
+static int serialize_binary_run(void *ctx, int nb_ops)
+{
+    struct scene_ctx *c = ctx;
+    for (int i = 0; i < nb_ops; i++) {
+        int size;
+        void *data = ngl_node_serialize_binary(c->scene, &size);
+        if (!data)
+            return NGL_ERROR_MEMORY;
+        free(data);
+    }
+    return 0;
+}
+
+static int deserialize_text_run(void *ctx, int nb_ops)
+{
+    const struct scene_ctx *c = ctx;
+    for (int i = 0; i < nb_ops; i++) {
+        struct ngl_node *scene = ngl_node_deserialize(c->text);
+        if (!scene)
+            return NGL_ERROR_INVALID_DATA;
+        ngl_node_unrefp(&scene);
+    }
+    return 0;
+}
+
+static int deserialize_binary_run(void *ctx, int nb_ops)
+{
+    const struct scene_ctx *c = ctx;
+    for (int i = 0; i < nb_ops; i++) {
+        struct ngl_node *scene = ngl_node_deserialize_binary(c->bin, c->bin_size);
+        if (!scene)
+            return NGL_ERROR_INVALID_DATA;
+        ngl_node_unrefp(&scene);
+    }
+    return 0;
+}
+
+static const struct bench benches[] = {
+    {"hmap_str_set",        NB_KEYS,  hmap_empty_init,  hmap_str_set_run,       hmap_uninit},
+    {"hmap_str_get",        1000000,  hmap_filled_init, hmap_str_get_run,       hmap_uninit},
+    {"hmap_u64_set",        NB_KEYS,  NULL,             hmap_u64_set_run,       NULL},
+    {"hmap_u64_get",        1000000,  hmap_filled_init, hmap_u64_get_run,       hmap_uninit},
+    {"darray_push",         1000000,  NULL,             darray_push_run,        NULL},
+    {"mat4_mul",            10000000, NULL,             mat4_mul_run,           NULL},
+    {"mat4_mul_vec4",       10000000, NULL,             mat4_mul_vec4_run,      NULL},
+    {"anim_evaluate",       1000000,  anim_init,        anim_evaluate_run,      node_uninit},
+    {"block_layout",        100000,   block_init,       block_layout_run,       node_uninit},
+    {"serialize_text",      20,       scene_init,       serialize_text_run,     scene_uninit},
+    {"serialize_binary",    20,       scene_init,       serialize_binary_run,   scene_uninit},
+    {"deserialize_text",    20,       scene_init,       deserialize_text_run,   scene_uninit},
+    {"deserialize_binary",  20,       scene_init,       deserialize_binary_run, scene_uninit},
+};
+
+int main(int ac, char **av)
+{
+    const char *filter = ac > 1 ? av[1] : NULL;
+
+    ngl_log_set_min_level(NGL_LOG_WARNING);
+
+    for (int i = 0; i < NGLI_ARRAY_NB(benches); i++) {
+        const struct bench *b = &benches[i];
+        if (filter && !strstr(b->name, filter))
+            continue;
+
+        void *ctx = NULL;
+        int ret = b->init ? b->init(&ctx) : 0;
+        int64_t best = INT64_MAX;
+        for (int run = 0; run < NB_RUNS && ret >= 0; run++) {
+            const int64_t start = ngli_gettime_relative();
+            ret = b->run(ctx, b->nb_ops);
+            const int64_t elapsed = ngli_gettime_relative() - start;
+            best = NGLI_MIN(best, elapsed);
+        }
+        if (b->uninit)
+            b->uninit(&ctx);
+        if (ret < 0) {
+            fprintf(stderr, "%s: failed with error %d\n", b->name, ret);
+            return EXIT_FAILURE;
+        }
+
+        printf("%-20s %12.1f ns/op  (%d ops)\n", b->name, best * 1000. / b->nb_ops, b->nb_ops);
+    }
+
+    return 0;
+}
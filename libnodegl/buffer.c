@@ -22,8 +22,10 @@
 #include <string.h>
 
 #include "buffer.h"
+#include "gctx.h"
 #include "glcontext.h"
 #include "glincludes.h"
+#include "log.h"
 #include "nodes.h"
 
 static const GLenum gl_usage_map[NGLI_BUFFER_USAGE_NB] = {
@@ -41,6 +43,7 @@ int ngli_buffer_init(struct buffer *s, struct ngl_ctx *ctx, int size, int usage)
     s->ctx = ctx;
     s->size = size;
     s->usage = usage;
+    s->barriers = GL_BUFFER_UPDATE_BARRIER_BIT;
     struct glcontext *gl = ctx->glcontext;
     ngli_glGenBuffers(gl, 1, &s->id);
     ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->id);
@@ -48,12 +51,23 @@ int ngli_buffer_init(struct buffer *s, struct ngl_ctx *ctx, int size, int usage)
     return 0;
 }
 
-int ngli_buffer_upload(struct buffer *s, const void *data, int size)
+int ngli_buffer_upload(struct buffer *s, const void *data, int offset, int size)
 {
     struct ngl_ctx *ctx = s->ctx;
     struct glcontext *gl = ctx->glcontext;
+
+    if (offset < 0 || size < 0 || offset + size > s->size) {
+        LOG(ERROR, "upload range [%d;%d] is out of the buffer bounds [0;%d]",
+            offset, offset + size, s->size);
+        return NGL_ERROR_INVALID_ARG;
+    }
+
+    if (!size)
+        return 0;
+
     ngli_glBindBuffer(gl, GL_ARRAY_BUFFER, s->id);
-    ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, 0, size, data);
+    ngli_gctx_flush_memory_barriers(ctx);
+    ngli_glBufferSubData(gl, GL_ARRAY_BUFFER, offset, size, data);
     return 0;
 }
 
@@ -37,10 +37,11 @@ struct buffer {
     int size;
     int usage;
     GLuint id;
+    GLbitfield barriers; // memory barriers required by the consumers of the buffer after a shader wrote to it
 };
 
 int ngli_buffer_init(struct buffer *s, struct ngl_ctx *ctx, int size, int usage);
-int ngli_buffer_upload(struct buffer *s, const void *data, int size);
+int ngli_buffer_upload(struct buffer *s, const void *data, int offset, int size);
 void ngli_buffer_reset(struct buffer *s);
 
 #endif
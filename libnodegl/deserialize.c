@@ -20,6 +20,7 @@
  */
 
 #include <inttypes.h>
+#include <limits.h>
 #include <stdio.h>
 #include <string.h>
 
@@ -216,7 +217,8 @@ static struct ngl_node **get_abs_node(struct darray *nodes_array, int id)
 }
 
 static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
-                       const struct node_param *par, const char *str)
+                       const struct node_param *par, const char *str,
+                       const char *end)
 {
     int len = -1;
 
@@ -279,23 +281,22 @@ static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
             int size = 0;
             int consumed = 0;
             const char *cur = str;
-            const char *end = str + strlen(str);
             int ret = sscanf(str, "%d,%n", &size, &consumed);
             if (ret != 1)
                 return NGL_ERROR_INVALID_DATA;
             if (!size)
                 break;
-            if (cur >= end - consumed)
+            if (size < 0 || cur >= end - consumed)
                 return NGL_ERROR_INVALID_DATA;
             cur += consumed;
-            uint8_t *data = ngli_calloc(size, sizeof(*data));
+            if (size > (end - cur) / 2)
+                return NGL_ERROR_INVALID_DATA;
+
+            /* Decode directly into the parameter storage */
+            uint8_t *data = ngli_params_alloc_data(base_ptr, par, size);
             if (!data)
                 return NGL_ERROR_MEMORY;
             for (int i = 0; i < size; i++) {
-                if (cur > end - 2) {
-                    ngli_free(data);
-                    return NGL_ERROR_INVALID_DATA;
-                }
                 static const uint8_t hexm[256] = {
                     ['0'] = 0x0, ['1'] = 0x1, ['2'] = 0x2, ['3'] = 0x3,
                     ['4'] = 0x4, ['5'] = 0x5, ['6'] = 0x6, ['7'] = 0x7,
@@ -305,10 +306,6 @@ static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
                 data[i] = hexm[(uint8_t)cur[0]]<<4 | hexm[(uint8_t)cur[1]];
                 cur += 2;
             }
-            ret = ngli_params_vset(base_ptr, par, size, data);
-            ngli_free(data);
-            if (ret < 0)
-                return ret;
             len = cur - str;
             break;
         }
@@ -424,8 +421,8 @@ static int parse_param(struct darray *nodes_array, uint8_t *base_ptr,
     return len;
 }
 
-static int set_node_params(struct darray *nodes_array, char *str,
-                           const struct ngl_node *node)
+static int set_node_params(struct darray *nodes_array, const char *str,
+                           const char *end, const struct ngl_node *node)
 {
     uint8_t *base_ptr = node->priv_data;
     const struct node_param *params = node->class->params;
@@ -439,11 +436,11 @@ static int set_node_params(struct darray *nodes_array, char *str,
         if (!(par->flags & PARAM_FLAG_CONSTRUCTOR))
             break;
 
-        int ret = parse_param(nodes_array, base_ptr, par, str);
-        if (ret < 0) {
+        int ret = parse_param(nodes_array, base_ptr, par, str, end);
+        if (ret < 0 || ret > end - str) {
             LOG(ERROR, "invalid value specified for parameter %s.%s",
                 node->class->name, par->key);
-            return ret;
+            return ret < 0 ? ret : NGL_ERROR_INVALID_DATA;
         }
 
         str += ret;
@@ -453,21 +450,29 @@ static int set_node_params(struct darray *nodes_array, char *str,
     }
 
     for (;;) {
-        char *eok = strchr(str, ':');
+        const char *eok = memchr(str, ':', end - str);
         if (!eok)
             break;
-        *eok = 0;
 
-        const struct node_param *par = ngli_node_param_find(node, str, &base_ptr);
+        char key[64];
+        const int key_len = eok - str;
+        if (key_len >= sizeof(key)) {
+            LOG(ERROR, "invalid parameter name in %s", node->class->name);
+            return NGL_ERROR_INVALID_DATA;
+        }
+        memcpy(key, str, key_len);
+        key[key_len] = 0;
+
+        const struct node_param *par = ngli_node_param_find(node, key, &base_ptr);
         if (!par) {
             LOG(ERROR, "unable to find parameter %s.%s",
-                node->class->name, str);
+                node->class->name, key);
             return NGL_ERROR_INVALID_DATA;
         }
 
         str = eok + 1;
-        int ret = parse_param(nodes_array, base_ptr, par, str);
-        if (ret < 0) {
+        int ret = parse_param(nodes_array, base_ptr, par, str, end);
+        if (ret < 0 || ret > end - str) {
             LOG(ERROR, "invalid value specified for parameter %s.%s",
                 node->class->name, par->key);
             return NGL_ERROR_INVALID_DATA;
@@ -482,19 +487,353 @@ static int set_node_params(struct darray *nodes_array, char *str,
     return 0;
 }
 
-struct ngl_node *ngl_node_deserialize(const char *str)
+struct bin_reader {
+    const uint8_t *p;
+    const uint8_t *end;
+};
+
+static int bin_read(struct bin_reader *r, const uint8_t **datap, uint32_t size)
+{
+    if (size > r->end - r->p)
+        return NGL_ERROR_INVALID_DATA;
+    *datap = r->p;
+    r->p += size;
+    return 0;
+}
+
+static int bin_read_u32(struct bin_reader *r, uint32_t *vp)
+{
+    const uint8_t *b;
+    int ret = bin_read(r, &b, 4);
+    if (ret < 0)
+        return ret;
+    *vp = b[0] | b[1] << 8 | b[2] << 16 | (uint32_t)b[3] << 24;
+    return 0;
+}
+
+static int bin_read_u64(struct bin_reader *r, uint64_t *vp)
+{
+    uint32_t lo, hi;
+    int ret;
+    if ((ret = bin_read_u32(r, &lo)) < 0 ||
+        (ret = bin_read_u32(r, &hi)) < 0)
+        return ret;
+    *vp = (uint64_t)hi << 32 | lo;
+    return 0;
+}
+
+static int bin_read_floats(struct bin_reader *r, int n, float *f)
+{
+    for (int i = 0; i < n; i++) {
+        union { uint32_t i; float f; } u;
+        int ret = bin_read_u32(r, &u.i);
+        if (ret < 0)
+            return ret;
+        f[i] = u.f;
+    }
+    return 0;
+}
+
+static int bin_read_doubles(struct bin_reader *r, int n, double *f)
+{
+    for (int i = 0; i < n; i++) {
+        union { uint64_t i; double f; } u;
+        int ret = bin_read_u64(r, &u.i);
+        if (ret < 0)
+            return ret;
+        f[i] = u.f;
+    }
+    return 0;
+}
+
+/* Read a string into a newly allocated zero-terminated string */
+static int bin_read_str(struct bin_reader *r, char **sp)
+{
+    uint32_t len;
+    const uint8_t *data;
+    int ret;
+    if ((ret = bin_read_u32(r, &len)) < 0 ||
+        (ret = bin_read(r, &data, len)) < 0)
+        return ret;
+    char *s = ngli_malloc(len + 1);
+    if (!s)
+        return NGL_ERROR_MEMORY;
+    memcpy(s, data, len);
+    s[len] = 0;
+    *sp = s;
+    return 0;
+}
+
+static int bin_read_node(struct bin_reader *r, struct darray *nodes_array,
+                         struct ngl_node **nodep)
+{
+    uint32_t id;
+    int ret = bin_read_u32(r, &id);
+    if (ret < 0)
+        return ret;
+    if (id >= ngli_darray_count(nodes_array))
+        return NGL_ERROR_INVALID_DATA;
+    *nodep = *(struct ngl_node **)ngli_darray_get(nodes_array, id);
+    return 0;
+}
+
+static int parse_param_bin(struct darray *nodes_array, uint8_t *base_ptr,
+                           const struct node_param *par, struct bin_reader *r)
+{
+    int ret;
+
+    switch (par->type) {
+        case PARAM_TYPE_BOOL:
+        case PARAM_TYPE_INT: {
+            uint32_t v;
+            if ((ret = bin_read_u32(r, &v)) < 0)
+                return ret;
+            return ngli_params_vset(base_ptr, par, (int)v);
+        }
+
+        case PARAM_TYPE_I64: {
+            uint64_t v;
+            if ((ret = bin_read_u64(r, &v)) < 0)
+                return ret;
+            return ngli_params_vset(base_ptr, par, (int64_t)v);
+        }
+
+        case PARAM_TYPE_DBL: {
+            double v;
+            if ((ret = bin_read_doubles(r, 1, &v)) < 0)
+                return ret;
+            return ngli_params_vset(base_ptr, par, v);
+        }
+
+        case PARAM_TYPE_RATIONAL: {
+            uint32_t num, den;
+            if ((ret = bin_read_u32(r, &num)) < 0 ||
+                (ret = bin_read_u32(r, &den)) < 0)
+                return ret;
+            return ngli_params_vset(base_ptr, par, (int)num, (int)den);
+        }
+
+        case PARAM_TYPE_FLAGS:
+        case PARAM_TYPE_SELECT:
+        case PARAM_TYPE_STR: {
+            char *s;
+            if ((ret = bin_read_str(r, &s)) < 0)
+                return ret;
+            ret = ngli_params_vset(base_ptr, par, s);
+            ngli_free(s);
+            return ret;
+        }
+
+        case PARAM_TYPE_DATA: {
+            uint32_t size;
+            const uint8_t *data;
+            if ((ret = bin_read_u32(r, &size)) < 0 ||
+                (ret = bin_read(r, &data, size)) < 0)
+                return ret;
+            if (size > INT_MAX)
+                return NGL_ERROR_INVALID_DATA;
+            return ngli_params_vset(base_ptr, par, (int)size, data);
+        }
+
+        case PARAM_TYPE_VEC2:
+        case PARAM_TYPE_VEC3:
+        case PARAM_TYPE_VEC4:
+        case PARAM_TYPE_MAT4: {
+            float v[16];
+            const int n = par->type == PARAM_TYPE_MAT4 ? 16 : par->type - PARAM_TYPE_VEC2 + 2;
+            if ((ret = bin_read_floats(r, n, v)) < 0)
+                return ret;
+            return ngli_params_vset(base_ptr, par, v);
+        }
+
+        case PARAM_TYPE_NODE: {
+            struct ngl_node *node;
+            if ((ret = bin_read_node(r, nodes_array, &node)) < 0)
+                return ret;
+            return ngli_params_vset(base_ptr, par, node);
+        }
+
+        case PARAM_TYPE_NODELIST: {
+            uint32_t nb_nodes;
+            if ((ret = bin_read_u32(r, &nb_nodes)) < 0)
+                return ret;
+            for (uint32_t i = 0; i < nb_nodes; i++) {
+                struct ngl_node *node;
+                if ((ret = bin_read_node(r, nodes_array, &node)) < 0 ||
+                    (ret = ngli_params_add(base_ptr, par, 1, &node)) < 0)
+                    return ret;
+            }
+            return 0;
+        }
+
+        case PARAM_TYPE_DBLLIST: {
+            uint32_t nb_dbls;
+            if ((ret = bin_read_u32(r, &nb_dbls)) < 0)
+                return ret;
+            if (nb_dbls > (r->end - r->p) / sizeof(double))
+                return NGL_ERROR_INVALID_DATA;
+            double *dbls = ngli_calloc(nb_dbls, sizeof(*dbls));
+            if (!dbls)
+                return NGL_ERROR_MEMORY;
+            ret = bin_read_doubles(r, nb_dbls, dbls);
+            if (ret >= 0)
+                ret = ngli_params_add(base_ptr, par, nb_dbls, dbls);
+            ngli_free(dbls);
+            return ret;
+        }
+
+        case PARAM_TYPE_NODEDICT: {
+            uint32_t nb_nodes;
+            if ((ret = bin_read_u32(r, &nb_nodes)) < 0)
+                return ret;
+            for (uint32_t i = 0; i < nb_nodes; i++) {
+                char *key;
+                struct ngl_node *node;
+                if ((ret = bin_read_str(r, &key)) < 0)
+                    return ret;
+                ret = bin_read_node(r, nodes_array, &node);
+                if (ret >= 0)
+                    ret = ngli_params_vset(base_ptr, par, key, node);
+                ngli_free(key);
+                if (ret < 0)
+                    return ret;
+            }
+            return 0;
+        }
+    }
+
+    LOG(ERROR, "cannot deserialize %s: unsupported parameter type", par->key);
+    return NGL_ERROR_UNSUPPORTED;
+}
+
+static int set_node_params_bin(struct darray *nodes_array, struct bin_reader *r,
+                               const struct ngl_node *node)
+{
+    for (;;) {
+        uint32_t len, type;
+        const uint8_t *key_data;
+        char key[64];
+        int ret;
+
+        if ((ret = bin_read_u32(r, &len)) < 0)
+            return ret;
+        if (!len)
+            break;
+        if (len >= sizeof(key) ||
+            (ret = bin_read(r, &key_data, len)) < 0 ||
+            (ret = bin_read_u32(r, &type)) < 0)
+            return NGL_ERROR_INVALID_DATA;
+        memcpy(key, key_data, len);
+        key[len] = 0;
+
+        uint8_t *base_ptr;
+        const struct node_param *par = ngli_node_param_find(node, key, &base_ptr);
+        if (!par)
+            return NGL_ERROR_INVALID_DATA;
+        if (par->type != type) {
+            LOG(ERROR, "mismatching type for parameter %s.%s", node->class->name, key);
+            return NGL_ERROR_INVALID_DATA;
+        }
+
+        ret = parse_param_bin(nodes_array, base_ptr, par, r);
+        if (ret < 0) {
+            LOG(ERROR, "invalid value specified for parameter %s.%s",
+                node->class->name, par->key);
+            return ret;
+        }
+    }
+
+    return 0;
+}
+
+struct ngl_node *ngl_node_deserialize_binary(const void *buf, int buf_size)
 {
     struct ngl_node *node = NULL;
     struct darray nodes_array;
+    const uint8_t *data = buf;
 
     ngli_darray_init(&nodes_array, sizeof(struct ngl_node *), 0);
 
-    char *s = ngli_strdup(str);
-    if (!s)
+    if (!data || buf_size < NGLI_SERIALIZE_BIN_HEADER_SIZE ||
+        memcmp(data, NGLI_SERIALIZE_BIN_MAGIC, 4)) {
+        LOG(ERROR, "invalid serialized scene");
+        goto end;
+    }
+
+    struct bin_reader r = {.p = data + 4, .end = data + NGLI_SERIALIZE_BIN_HEADER_SIZE};
+    uint32_t version, lib_version, size, nb_nodes;
+    if (bin_read_u32(&r, &version) < 0 ||
+        bin_read_u32(&r, &lib_version) < 0 ||
+        bin_read_u32(&r, &size) < 0 ||
+        bin_read_u32(&r, &nb_nodes) < 0 ||
+        size < NGLI_SERIALIZE_BIN_HEADER_SIZE || size > buf_size) {
+        LOG(ERROR, "invalid serialized scene");
+        goto end;
+    }
+    if (version != NGLI_SERIALIZE_BIN_VERSION) {
+        LOG(ERROR, "unsupported binary format version %u", version);
+        goto end;
+    }
+    if (lib_version != NODEGL_VERSION_INT) {
+        LOG(ERROR, "mismatching version: %u.%u.%u != %d.%d.%d",
+            lib_version >> 16, lib_version >> 8 & 0xff, lib_version & 0xff,
+            NODEGL_VERSION_MAJOR, NODEGL_VERSION_MINOR, NODEGL_VERSION_MICRO);
+        goto end;
+    }
+    r.end = data + size;
+
+    for (uint32_t i = 0; i < nb_nodes; i++) {
+        uint32_t type;
+        if (bin_read_u32(&r, &type) < 0) {
+            LOG(ERROR, "invalid serialized scene");
+            node = NULL;
+            break;
+        }
+
+        node = ngli_node_create_noconstructor(type);
+        if (!node)
+            break;
+
+        if (!ngli_darray_push(&nodes_array, &node)) {
+            ngl_node_unrefp(&node);
+            break;
+        }
+
+        int ret = set_node_params_bin(&nodes_array, &r, node);
+        if (ret < 0) {
+            node = NULL;
+            break;
+        }
+    }
+
+    if (node)
+        ngl_node_ref(node);
+
+    struct ngl_node **nodes = ngli_darray_data(&nodes_array);
+    for (int i = 0; i < ngli_darray_count(&nodes_array); i++)
+        ngl_node_unrefp(&nodes[i]);
+
+end:
+    ngli_darray_reset(&nodes_array);
+    return node;
+}
+
+struct ngl_node *ngl_node_deserialize(const char *str)
+{
+    struct ngl_node *node = NULL;
+    struct darray nodes_array;
+
+    if (!strncmp(str, NGLI_SERIALIZE_BIN_MAGIC, 4)) {
+        LOG(ERROR, "binary scenes must be de-serialized with ngl_node_deserialize_binary()");
         return NULL;
+    }
+
+    ngli_darray_init(&nodes_array, sizeof(struct ngl_node *), 0);
 
-    char *sstart = s;
-    char *send = s + strlen(s);
+    /* The input is parsed in place: every line is bounded by its end pointer
+     * instead of being split, so no copy of the whole input is needed */
+    const char *s = str;
+    const char *send = s + strlen(s);
 
     int major, minor, micro;
     int n = sscanf(s, "# Node.GL v%d.%d.%d", &major, &minor, &micro);
@@ -527,10 +866,9 @@ struct ngl_node *ngl_node_deserialize(const char *str)
             break;
         }
 
-        size_t eol = strcspn(s, "\n");
-        s[eol] = 0;
+        const size_t eol = strcspn(s, "\n");
 
-        int ret = set_node_params(&nodes_array, s, node);
+        int ret = set_node_params(&nodes_array, s, s + eol, node);
         if (ret < 0) {
             node = NULL;
             break;
@@ -548,6 +886,5 @@ struct ngl_node *ngl_node_deserialize(const char *str)
 
 end:
     ngli_darray_reset(&nodes_array);
-    ngli_free(sstart);
     return node;
 }
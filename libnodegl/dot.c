@@ -36,13 +36,9 @@ extern const struct node_param ngli_base_node_params[];
 
 static int visited(struct hmap *ptr_set, const void *id)
 {
-    char key[32];
-    int ret = snprintf(key, sizeof(key), "%p", id);
-    if (ret < 0)
-        return ret;
-    if (ngli_hmap_get(ptr_set, key))
+    if (ngli_hmap_get_u64(ptr_set, (uintptr_t)id))
         return 1;
-    return ngli_hmap_set(ptr_set, key, "");
+    return ngli_hmap_set_u64(ptr_set, (uintptr_t)id, "");
 }
 
 static unsigned get_hue(const char *name)
@@ -298,8 +294,8 @@ char *ngl_node_dot(const struct ngl_node *node)
         return NULL;
 
     char *graph = NULL;
-    struct hmap *decls = ngli_hmap_create();
-    struct hmap *links = ngli_hmap_create();
+    struct hmap *decls = ngli_hmap_create_u64();
+    struct hmap *links = ngli_hmap_create_u64();
     struct bstr *b = ngli_bstr_create();
     if (!decls || !links || !b)
         goto end;
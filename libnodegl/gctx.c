@@ -93,3 +93,97 @@ void ngli_gctx_invalidate_depth_stencil(struct ngl_ctx *s)
     static const GLenum attachments[] = {GL_DEPTH_ATTACHMENT, GL_STENCIL_ATTACHMENT};
     ngli_glInvalidateFramebuffer(gl, GL_FRAMEBUFFER, NGLI_ARRAY_NB(attachments), attachments);
 }
+
+/*
+ * The texture bindings made through ngli_gctx_bind_texture() are recorded
+ * per texture unit so redundant binds can be skipped. Code binding textures
+ * by other means (uploads, hardware mappers, ...) does it on the active unit
+ * and must call ngli_gctx_invalidate_active_texture() afterwards.
+ */
+void ngli_gctx_reset_texture_bindings(struct ngl_ctx *s)
+{
+    s->active_texture_unit = -1;
+    memset(s->texture_bindings, 0, sizeof(s->texture_bindings));
+}
+
+void ngli_gctx_set_active_texture(struct ngl_ctx *s, int unit)
+{
+    struct glcontext *gl = s->glcontext;
+
+    if (s->active_texture_unit == unit)
+        return;
+
+    ngli_glActiveTexture(gl, GL_TEXTURE0 + unit);
+    s->active_texture_unit = unit;
+}
+
+/* A zero id unbinds every texture target that can be sampled from the unit */
+void ngli_gctx_bind_texture(struct ngl_ctx *s, int unit, GLenum target, GLuint id)
+{
+    struct glcontext *gl = s->glcontext;
+
+    ngli_assert(unit >= 0 && unit < NGLI_MAX_TEXTURE_UNITS);
+    struct texture_binding *binding = &s->texture_bindings[unit];
+    if (!id)
+        target = GL_NONE;
+    if (binding->known && binding->target == target && binding->id == id)
+        return;
+
+    ngli_gctx_set_active_texture(s, unit);
+    if (id) {
+        ngli_glBindTexture(gl, target, id);
+    } else {
+        ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+        if (gl->features & NGLI_FEATURE_TEXTURE_3D)
+            ngli_glBindTexture(gl, GL_TEXTURE_3D, 0);
+        if (gl->features & NGLI_FEATURE_OES_EGL_EXTERNAL_IMAGE)
+            ngli_glBindTexture(gl, GL_TEXTURE_EXTERNAL_OES, 0);
+    }
+
+    binding->known  = 1;
+    binding->target = target;
+    binding->id     = id;
+}
+
+void ngli_gctx_invalidate_active_texture(struct ngl_ctx *s)
+{
+    if (s->active_texture_unit < 0) {
+        memset(s->texture_bindings, 0, sizeof(s->texture_bindings));
+        return;
+    }
+    s->texture_bindings[s->active_texture_unit].known = 0;
+}
+
+/* Deleting a texture implicitly unbinds it from all the units */
+void ngli_gctx_invalidate_texture(struct ngl_ctx *s, GLuint id)
+{
+    for (int i = 0; i < NGLI_MAX_TEXTURE_UNITS; i++) {
+        struct texture_binding *binding = &s->texture_bindings[i];
+        if (binding->id == id)
+            binding->known = 0;
+    }
+}
+
+/*
+ * Memory barriers are deferred until the next command that may consume the
+ * data written by the shaders, so that the barriers of consecutive dispatches
+ * are merged into a single one.
+ */
+void ngli_gctx_memory_barrier(struct ngl_ctx *s, GLbitfield barriers)
+{
+    struct glcontext *gl = s->glcontext;
+
+    if (!(gl->features & NGLI_FEATURE_COMPUTE_SHADER))
+        return;
+    s->pending_barriers |= barriers;
+}
+
+void ngli_gctx_flush_memory_barriers(struct ngl_ctx *s)
+{
+    struct glcontext *gl = s->glcontext;
+
+    if (!s->pending_barriers)
+        return;
+    ngli_glMemoryBarrier(gl, s->pending_barriers);
+    s->pending_barriers = 0;
+}
@@ -38,4 +38,13 @@ void ngli_gctx_clear_color(struct ngl_ctx *s);
 void ngli_gctx_clear_depth_stencil(struct ngl_ctx *s);
 void ngli_gctx_invalidate_depth_stencil(struct ngl_ctx *s);
 
+void ngli_gctx_reset_texture_bindings(struct ngl_ctx *s);
+void ngli_gctx_bind_texture(struct ngl_ctx *s, int unit, GLenum target, GLuint id);
+void ngli_gctx_set_active_texture(struct ngl_ctx *s, int unit);
+void ngli_gctx_invalidate_active_texture(struct ngl_ctx *s);
+void ngli_gctx_invalidate_texture(struct ngl_ctx *s, GLuint id);
+
+void ngli_gctx_memory_barrier(struct ngl_ctx *s, GLbitfield barriers);
+void ngli_gctx_flush_memory_barriers(struct ngl_ctx *s);
+
 #endif
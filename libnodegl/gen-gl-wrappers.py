@@ -99,6 +99,11 @@ cmds_optional = [
     'glFenceSync',
     'glWaitSync',
     'glClientWaitSync',
+    'glDeleteSync',
+
+    # Buffer mapping
+    'glMapBufferRange',
+    'glUnmapBuffer',
 
     # Read/Draw Buffer
     'glReadBuffer',
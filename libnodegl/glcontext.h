@@ -55,6 +55,7 @@
 #define NGLI_FEATURE_DRAW_BUFFERS                 (1 << 26)
 #define NGLI_FEATURE_ROW_LENGTH                   (1 << 27)
 #define NGLI_FEATURE_SOFTWARE                     (1 << 28)
+#define NGLI_FEATURE_MAP_BUFFER_RANGE             (1 << 29)
 
 #define NGLI_FEATURE_COMPUTE_SHADER_ALL (NGLI_FEATURE_COMPUTE_SHADER           | \
                                          NGLI_FEATURE_PROGRAM_INTERFACE_QUERY  | \
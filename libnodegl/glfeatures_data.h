@@ -208,6 +208,7 @@ static const struct glfeature {
         .funcs_offsets  = (const size_t[]){OFFSET(FenceSync),
                                            OFFSET(ClientWaitSync),
                                            OFFSET(WaitSync),
+                                           OFFSET(DeleteSync),
                                            -1}
     }, {
         .name           = "yuv_target",
@@ -241,5 +242,14 @@ static const struct glfeature {
         .flag           = NGLI_FEATURE_ROW_LENGTH,
         .version        = 300,
         .es_version     = 300,
+    }, {
+        .name           = "map_buffer_range",
+        .flag           = NGLI_FEATURE_MAP_BUFFER_RANGE,
+        .version        = 300,
+        .es_version     = 300,
+        .extensions     = (const char*[]){"GL_ARB_map_buffer_range", NULL},
+        .funcs_offsets  = (const size_t[]){OFFSET(MapBufferRange),
+                                           OFFSET(UnmapBuffer),
+                                           -1}
     }
 };
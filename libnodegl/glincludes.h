@@ -79,6 +79,9 @@ typedef void* GLeglImageOES;
 # define GL_MAX_COLOR_ATTACHMENTS              0x8CDF
 # define GL_SYNC_GPU_COMMANDS_COMPLETE         0x9117
 # define GL_TIMEOUT_IGNORED                    0xFFFFFFFFFFFFFFFFull
+# define GL_SYNC_FLUSH_COMMANDS_BIT            0x00000001
+# define GL_PIXEL_PACK_BUFFER                  0x88EB
+# define GL_MAP_READ_BIT                       0x0001
 # define GL_TEXTURE_RECTANGLE                  0x84F5
 # define GL_STENCIL_INDEX                      0x1901
 # define GL_STENCIL_INDEX8                     0x8D48
@@ -223,6 +226,7 @@ typedef void* GLeglImageOES;
 # define GL_FRAMEBUFFER_BARRIER_BIT            0x00000400
 # define GL_TRANSFORM_FEEDBACK_BARRIER_BIT     0x00000800
 # define GL_ATOMIC_COUNTER_BARRIER_BIT         0x00001000
+# define GL_SHADER_STORAGE_BARRIER_BIT         0x00002000
 # define GL_ALL_BARRIER_BITS                   0xFFFFFFFF
 # define GL_IMAGE_2D                           0x904D
 # define GL_ACTIVE_RESOURCES                   0x92F5
@@ -234,6 +234,12 @@ static inline void ngli_glDeleteShader(const struct glcontext *gl, GLuint shader
     check_error_code(gl, "glDeleteShader");
 }
 
+static inline void ngli_glDeleteSync(const struct glcontext *gl, GLsync sync)
+{
+    gl->funcs.DeleteSync(sync);
+    check_error_code(gl, "glDeleteSync");
+}
+
 static inline void ngli_glDeleteTextures(const struct glcontext *gl, GLsizei n, const GLuint * textures)
 {
     gl->funcs.DeleteTextures(n, textures);
@@ -613,6 +619,13 @@ static inline void ngli_glLinkProgram(const struct glcontext *gl, GLuint program
     check_error_code(gl, "glLinkProgram");
 }
 
+static inline void * ngli_glMapBufferRange(const struct glcontext *gl, GLenum target, GLintptr offset, GLsizeiptr length, GLbitfield access)
+{
+    void * ret = gl->funcs.MapBufferRange(target, offset, length, access);
+    check_error_code(gl, "glMapBufferRange");
+    return ret;
+}
+
 static inline void ngli_glMemoryBarrier(const struct glcontext *gl, GLbitfield barriers)
 {
     gl->funcs.MemoryBarrier(barriers);
@@ -877,6 +890,13 @@ static inline void ngli_glUniformMatrix4fv(const struct glcontext *gl, GLint loc
     check_error_code(gl, "glUniformMatrix4fv");
 }
 
+static inline GLboolean ngli_glUnmapBuffer(const struct glcontext *gl, GLenum target)
+{
+    GLboolean ret = gl->funcs.UnmapBuffer(target);
+    check_error_code(gl, "glUnmapBuffer");
+    return ret;
+}
+
 static inline void ngli_glUseProgram(const struct glcontext *gl, GLuint program)
 {
     gl->funcs.UseProgram(program);
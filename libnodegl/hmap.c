@@ -28,16 +28,47 @@
 #include "nodegl.h"
 #include "utils.h"
 
+/*
+ * Maximum number of buckets migrated from the previous table to the new one
+ * at each insertion while a rehash is in progress. Growing doubles the size
+ * of the table, and the next growth happens at least size*3/4 insertions
+ * later, so any value >= 1 guarantees the migration completes in time.
+ */
+#define HMAP_REHASH_NB_BUCKETS 4
+
+enum hmap_type {
+    HMAP_TYPE_STR,
+    HMAP_TYPE_U64,
+};
+
+union hmap_key {
+    const char *str;
+    uint64_t u64;
+};
+
 struct bucket {
     struct hmap_entry *entries;
     int nb_entries;
 };
 
-struct hmap {
+struct table {
     struct bucket *buckets;
     int size;
     uint32_t mask;
-    int count; // total number of entries
+};
+
+/*
+ * While growing, the map holds two tables: the current one, receiving the new
+ * entries, and the previous one, whose buckets are progressively migrated to
+ * the current one. Entries record the index of the table they live in, which
+ * means the tables never need to be renumbered when a new rehash starts.
+ */
+struct hmap {
+    enum hmap_type type;
+    struct table tables[2];
+    int cur;        // index of the current table
+    int rehash_pos; // next bucket of the previous table to migrate
+    int count;      // total number of entries
     user_free_func_type user_free_func;
     void *user_arg;
 };
@@ -48,156 +79,304 @@ void ngli_hmap_set_free(struct hmap *hm, user_free_func_type user_free_func, voi
     hm->user_arg = user_arg;
 }
 
-struct hmap *ngli_hmap_create(void)
+static int table_init(struct table *t, int size)
+{
+    t->buckets = ngli_calloc(size, sizeof(*t->buckets));
+    if (!t->buckets)
+        return NGL_ERROR_MEMORY;
+    t->size = size;
+    t->mask = size - 1;
+    return 0;
+}
+
+static void table_reset(struct table *t)
+{
+    ngli_free(t->buckets);
+    memset(t, 0, sizeof(*t));
+}
+
+static struct hmap *hmap_create(enum hmap_type type)
 {
     struct hmap *hm = ngli_calloc(1, sizeof(*hm));
     if (!hm)
         return NULL;
-    hm->size = 1 << HMAP_SIZE_NBIT;
-    hm->mask = hm->size - 1;
-    hm->buckets = ngli_calloc(hm->size, sizeof(*hm->buckets));
-    if (!hm->buckets) {
+    hm->type = type;
+    if (table_init(&hm->tables[0], 1 << HMAP_SIZE_NBIT) < 0) {
         ngli_free(hm);
         return NULL;
     }
     return hm;
 }
 
+struct hmap *ngli_hmap_create(void)
+{
+    return hmap_create(HMAP_TYPE_STR);
+}
+
+struct hmap *ngli_hmap_create_u64(void)
+{
+    return hmap_create(HMAP_TYPE_U64);
+}
+
 int ngli_hmap_count(const struct hmap *hm)
 {
     return hm->count;
 }
 
-int ngli_hmap_set(struct hmap *hm, const char *key, void *data)
+/* Final mix of MurmurHash3 (fmix64), spreads the aligned low bits of pointers */
+static uint32_t hash_u64(uint64_t x)
 {
-    if (!key)
-        return NGL_ERROR_INVALID_ARG;
+    x ^= x >> 33;
+    x *= 0xff51afd7ed558ccdULL;
+    x ^= x >> 33;
+    x *= 0xc4ceb9fe1a85ec53ULL;
+    x ^= x >> 33;
+    return (uint32_t)x;
+}
 
-    const uint32_t hash = ngli_crc32(key);
-    int id = hash & hm->mask;
-    struct bucket *b = &hm->buckets[id];
+static uint32_t key_hash(const struct hmap *hm, union hmap_key key)
+{
+    return hm->type == HMAP_TYPE_STR ? ngli_crc32(key.str) : hash_u64(key.u64);
+}
 
-    /* Delete */
-    if (!data) {
-        for (int i = 0; i < b->nb_entries; i++) {
-            struct hmap_entry *e = &b->entries[i];
-            if (!strcmp(e->key, key)) {
-                ngli_free(e->key);
-                if (hm->user_free_func)
-                    hm->user_free_func(hm->user_arg, e->data);
-                hm->count--;
-                b->nb_entries--;
-                if (!b->nb_entries) {
-                    ngli_free(b->entries);
-                } else {
-                    memmove(e, e + 1, (b->nb_entries - i) * sizeof(*b->entries));
-                    struct hmap_entry *entries =
-                        ngli_realloc(b->entries, b->nb_entries * sizeof(*b->entries));
-                    if (!entries)
-                        return 0; // unable to realloc but entry got dropped, so this is OK
-                    b->entries = entries;
-                }
-                return 1;
-            }
+static uint32_t entry_hash(const struct hmap *hm, const struct hmap_entry *e)
+{
+    return hm->type == HMAP_TYPE_STR ? ngli_crc32(e->key) : hash_u64(e->key_u64);
+}
+
+static int key_match(const struct hmap *hm, const struct hmap_entry *e, union hmap_key key)
+{
+    return hm->type == HMAP_TYPE_STR ? !strcmp(e->key, key.str) : e->key_u64 == key.u64;
+}
+
+static void entry_free_key(const struct hmap *hm, struct hmap_entry *e)
+{
+    if (hm->type == HMAP_TYPE_STR)
+        ngli_free(e->key);
+}
+
+static int is_rehashing(const struct hmap *hm)
+{
+    return hm->tables[hm->cur ^ 1].buckets != NULL;
+}
+
+static struct hmap_entry *find_entry(const struct hmap *hm, union hmap_key key, uint32_t hash)
+{
+    for (int i = 0; i < 2; i++) {
+        const struct table *t = &hm->tables[hm->cur ^ i];
+        if (!t->buckets)
+            continue;
+        const struct bucket *b = &t->buckets[hash & t->mask];
+        for (int j = 0; j < b->nb_entries; j++) {
+            struct hmap_entry *e = &b->entries[j];
+            if (key_match(hm, e, key))
+                return e;
         }
-        return 0;
     }
+    return NULL;
+}
 
-    /* Replace */
-    for (int i = 0; i < b->nb_entries; i++) {
-        struct hmap_entry *e = &b->entries[i];
-        if (!strcmp(e->key, key)) {
-            if (hm->user_free_func)
-                hm->user_free_func(hm->user_arg, e->data);
-            e->data = data;
-            return 0;
+static struct hmap_entry *bucket_add(struct hmap *hm, int table_id, int bucket_id)
+{
+    struct bucket *b = &hm->tables[table_id].buckets[bucket_id];
+    struct hmap_entry *entries =
+        ngli_realloc(b->entries, (b->nb_entries + 1) * sizeof(*b->entries));
+    if (!entries)
+        return NULL;
+    b->entries = entries;
+    struct hmap_entry *e = &entries[b->nb_entries++];
+    e->table_id = table_id;
+    e->bucket_id = bucket_id;
+    return e;
+}
+
+static void bucket_remove(struct bucket *b, struct hmap_entry *e)
+{
+    const int i = e - b->entries;
+    b->nb_entries--;
+    if (!b->nb_entries) {
+        ngli_free(b->entries);
+        b->entries = NULL;
+    } else {
+        memmove(e, e + 1, (b->nb_entries - i) * sizeof(*b->entries));
+        struct hmap_entry *entries =
+            ngli_realloc(b->entries, b->nb_entries * sizeof(*b->entries));
+        if (entries) // unable to realloc but entry got dropped, so this is OK
+            b->entries = entries;
+    }
+}
+
+/*
+ * Move the entries of the next buckets of the previous table to the current
+ * one. Entries are moved one at a time from the end of the bucket so that an
+ * allocation failure leaves every entry in exactly one table, and the
+ * migration can simply resume later.
+ */
+static int rehash_step(struct hmap *hm, int nb_buckets)
+{
+    const int prev = hm->cur ^ 1;
+    struct table *old = &hm->tables[prev];
+    struct table *new = &hm->tables[hm->cur];
+
+    while (nb_buckets-- && hm->rehash_pos < old->size) {
+        struct bucket *b = &old->buckets[hm->rehash_pos];
+        while (b->nb_entries) {
+            const struct hmap_entry *e = &b->entries[b->nb_entries - 1];
+            const int bucket_id = entry_hash(hm, e) & new->mask;
+            struct hmap_entry *new_e = bucket_add(hm, hm->cur, bucket_id);
+            if (!new_e)
+                return NGL_ERROR_MEMORY;
+            const struct hmap_entry tmp = *new_e;
+            *new_e = *e;
+            new_e->table_id = tmp.table_id;
+            new_e->bucket_id = tmp.bucket_id;
+            b->nb_entries--;
         }
+        ngli_free(b->entries);
+        b->entries = NULL;
+        hm->rehash_pos++;
     }
 
-    /* Resize check before addition  */
-    if (hm->count * 3 / 4 >= hm->size) {
-        struct hmap old_hm = *hm;
+    if (hm->rehash_pos == old->size)
+        table_reset(old);
+    return 0;
+}
 
-        if (hm->size >= 1 << (sizeof(hm->size)*8 - 2))
-            return NGL_ERROR_LIMIT_EXCEEDED;
+static int rehash_finish(struct hmap *hm)
+{
+    while (is_rehashing(hm)) {
+        int ret = rehash_step(hm, INT32_MAX);
+        if (ret < 0)
+            return ret;
+    }
+    return 0;
+}
 
-        struct bucket *new_buckets = ngli_calloc(hm->size << 1, sizeof(*new_buckets));
-        if (new_buckets) {
-            hm->buckets = new_buckets;
-            hm->count = 0;
-            hm->size <<= 1;
-            hm->mask = hm->size - 1;
-
-            if (old_hm.count) {
-                /* Transfer all entries to the new map */
-                const struct hmap_entry *e = NULL;
-                while ((e = ngli_hmap_next(&old_hm, e))) {
-                    const int new_id = ngli_crc32(e->key) & hm->mask;
-                    struct bucket *b = &hm->buckets[new_id];
-                    struct hmap_entry *entries =
-                        ngli_realloc(b->entries, (b->nb_entries + 1) * sizeof(*b->entries));
-                    if (!entries) {
-                        /* Unable to allocate more, ngli_free the incomplete buckets
-                         * and restore the previous hashmap state */
-                        for (int j = 0; j < hm->size; j++)
-                            ngli_free(hm->buckets[j].entries);
-                        ngli_free(hm->buckets);
-                        *hm = old_hm;
-                        return NGL_ERROR_MEMORY;
-                    }
-                    b->entries = entries;
-                    struct hmap_entry *new_e = &entries[b->nb_entries++];
-                    new_e->key = e->key;
-                    new_e->data = e->data;
-                    new_e->bucket_id = new_id;
-                    hm->count++;
-                }
-
-                /* Destroy previous indexes in the old buckets */
-                for (int j = 0; j < old_hm.size; j++) {
-                    struct bucket *b = &old_hm.buckets[j];
-                    ngli_free(b->entries);
-                    old_hm.count -= b->nb_entries;
-                    if (old_hm.count == 0)
-                        break;
-                }
-            }
+static int grow(struct hmap *hm, int size)
+{
+    int ret = rehash_finish(hm);
+    if (ret < 0)
+        return ret;
+
+    const int next = hm->cur ^ 1;
+    ret = table_init(&hm->tables[next], size);
+    if (ret < 0)
+        return ret;
+    hm->cur = next;
+    hm->rehash_pos = 0;
+    if (!hm->count)
+        table_reset(&hm->tables[next ^ 1]);
+    return 0;
+}
 
-            ngli_free(old_hm.buckets);
+static int hmap_set(struct hmap *hm, union hmap_key key, void *data)
+{
+    if (is_rehashing(hm)) {
+        int ret = rehash_step(hm, HMAP_REHASH_NB_BUCKETS);
+        if (ret < 0)
+            return ret;
+    }
 
-            /* Fix the bucket position for the entry to add */
-            id = hash & hm->mask;
-            b = &hm->buckets[id];
-        }
+    const uint32_t hash = key_hash(hm, key);
+    struct hmap_entry *e = find_entry(hm, key, hash);
+
+    /* Delete */
+    if (!data) {
+        if (!e)
+            return 0;
+        entry_free_key(hm, e);
+        if (hm->user_free_func)
+            hm->user_free_func(hm->user_arg, e->data);
+        hm->count--;
+        bucket_remove(&hm->tables[e->table_id].buckets[e->bucket_id], e);
+        return 1;
+    }
+
+    /* Replace */
+    if (e) {
+        if (hm->user_free_func)
+            hm->user_free_func(hm->user_arg, e->data);
+        e->data = data;
+        return 0;
+    }
+
+    /* Grow check before addition; the entries are migrated progressively by
+     * the next insertions */
+    const struct table *t = &hm->tables[hm->cur];
+    if (!is_rehashing(hm) && hm->count * 3 / 4 >= t->size) {
+        if (t->size >= 1 << (sizeof(t->size)*8 - 2))
+            return NGL_ERROR_LIMIT_EXCEEDED;
+        grow(hm, t->size << 1); // on failure, keep filling the current table
+        t = &hm->tables[hm->cur];
     }
 
     /* Add */
-    char *new_key = ngli_strdup(key);
-    if (!new_key)
-        return NGL_ERROR_MEMORY;
-    struct hmap_entry *entries =
-        ngli_realloc(b->entries, (b->nb_entries + 1) * sizeof(*b->entries));
-    if (!entries) {
+    char *new_key = NULL;
+    if (hm->type == HMAP_TYPE_STR) {
+        new_key = ngli_strdup(key.str);
+        if (!new_key)
+            return NGL_ERROR_MEMORY;
+    }
+    e = bucket_add(hm, hm->cur, hash & t->mask);
+    if (!e) {
         ngli_free(new_key);
         return NGL_ERROR_MEMORY;
     }
-    b->entries = entries;
-    struct hmap_entry *e = &entries[b->nb_entries++];
-    e->key = new_key;
+    if (hm->type == HMAP_TYPE_STR)
+        e->key = new_key;
+    else
+        e->key_u64 = key.u64;
     e->data = data;
-    e->bucket_id = id;
     hm->count++;
 
     return 0;
 }
 
+int ngli_hmap_set(struct hmap *hm, const char *key, void *data)
+{
+    ngli_assert(hm->type == HMAP_TYPE_STR);
+    if (!key)
+        return NGL_ERROR_INVALID_ARG;
+    const union hmap_key hkey = {.str = key};
+    return hmap_set(hm, hkey, data);
+}
+
+int ngli_hmap_set_u64(struct hmap *hm, uint64_t key, void *data)
+{
+    ngli_assert(hm->type == HMAP_TYPE_U64);
+    const union hmap_key hkey = {.u64 = key};
+    return hmap_set(hm, hkey, data);
+}
+
+int ngli_hmap_reserve(struct hmap *hm, int count)
+{
+    const struct table *t = &hm->tables[hm->cur];
+    int size = t->size;
+    while (count * 3 / 4 >= size) {
+        if (size >= 1 << (sizeof(size)*8 - 2))
+            return NGL_ERROR_LIMIT_EXCEEDED;
+        size <<= 1;
+    }
+    if (size != t->size) {
+        int ret = grow(hm, size);
+        if (ret < 0)
+            return ret;
+    }
+    return rehash_finish(hm);
+}
+
 static const struct hmap_entry *get_first_entry(const struct hmap *hm,
+                                                int table_start,
                                                 int bucket_start)
 {
-    for (int i = bucket_start; i < hm->size; i++) {
-        const struct bucket *b = &hm->buckets[i];
-        if (b->nb_entries)
-            return &b->entries[0];
+    for (int i = table_start; i < 2; i++) {
+        const struct table *t = &hm->tables[i];
+        for (int j = bucket_start; j < t->size; j++) {
+            const struct bucket *b = &t->buckets[j];
+            if (b->nb_entries)
+                return &b->entries[0];
+        }
+        bucket_start = 0;
     }
     return NULL;
 }
@@ -209,32 +388,32 @@ const struct hmap_entry *ngli_hmap_next(const struct hmap *hm,
         return NULL;
 
     if (!prev)
-        return get_first_entry(hm, 0);
+        return get_first_entry(hm, 0, 0);
 
     const int id = prev->bucket_id;
-    const struct bucket *b = &hm->buckets[id];
+    const struct bucket *b = &hm->tables[prev->table_id].buckets[id];
     const int entry_id = prev - b->entries;
 
     if (entry_id < b->nb_entries - 1)
         return &b->entries[entry_id + 1];
 
-    if (id < hm->size - 1)
-        return get_first_entry(hm, id + 1);
-
-    return NULL;
+    return get_first_entry(hm, prev->table_id, id + 1);
 }
 
 void *ngli_hmap_get(const struct hmap *hm, const char *key)
 {
-    const int id = ngli_crc32(key) & hm->mask;
-    const struct bucket *b = &hm->buckets[id];
+    ngli_assert(hm->type == HMAP_TYPE_STR);
+    const union hmap_key hkey = {.str = key};
+    const struct hmap_entry *e = find_entry(hm, hkey, key_hash(hm, hkey));
+    return e ? e->data : NULL;
+}
 
-    for (int i = 0; i < b->nb_entries; i++) {
-        struct hmap_entry *e = &b->entries[i];
-        if (!strcmp(e->key, key))
-            return e->data;
-    }
-    return NULL;
+void *ngli_hmap_get_u64(const struct hmap *hm, uint64_t key)
+{
+    ngli_assert(hm->type == HMAP_TYPE_U64);
+    const union hmap_key hkey = {.u64 = key};
+    const struct hmap_entry *e = find_entry(hm, hkey, key_hash(hm, hkey));
+    return e ? e->data : NULL;
 }
 
 void ngli_hmap_freep(struct hmap **hmp)
@@ -244,23 +423,22 @@ void ngli_hmap_freep(struct hmap **hmp)
     if (!hm)
         return;
 
-    if (hm->count) {
-        for (int j = 0; j < hm->size; j++) {
-            struct bucket *b = &hm->buckets[j];
+    for (int k = 0; k < 2; k++) {
+        struct table *t = &hm->tables[k];
+        for (int j = 0; j < t->size && hm->count; j++) {
+            struct bucket *b = &t->buckets[j];
             for (int i = 0; i < b->nb_entries; i++) {
                 struct hmap_entry *e = &b->entries[i];
-                ngli_free(e->key);
+                entry_free_key(hm, e);
                 if (hm->user_free_func)
                     hm->user_free_func(hm->user_arg, e->data);
             }
             ngli_free(b->entries);
             hm->count -= b->nb_entries;
-            if (hm->count == 0)
-                break;
         }
+        table_reset(t);
     }
 
-    ngli_free(hm->buckets);
     ngli_free(hm);
     *hmp = NULL;
 }
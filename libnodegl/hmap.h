@@ -26,21 +26,31 @@
 #define HMAP_SIZE_NBIT 3
 #endif
 
+#include <stdint.h>
+
 struct hmap;
 
 struct hmap_entry {
-    char *key;
+    union {
+        char *key;          // string keyed maps
+        uint64_t key_u64;   // integer keyed maps
+    };
     void *data;
+    int table_id;
     int bucket_id;
 };
 
 typedef void (*user_free_func_type)(void *user_arg, void *data);
 
 struct hmap *ngli_hmap_create(void);
+struct hmap *ngli_hmap_create_u64(void);
+int ngli_hmap_reserve(struct hmap *hm, int count);
 void ngli_hmap_set_free(struct hmap *hm, user_free_func_type user_free_func, void *user_arg);
 int ngli_hmap_count(const struct hmap *hm);
 int ngli_hmap_set(struct hmap *hm, const char *key, void *data);
 void *ngli_hmap_get(const struct hmap *hm, const char *key);
+int ngli_hmap_set_u64(struct hmap *hm, uint64_t key, void *data);
+void *ngli_hmap_get_u64(const struct hmap *hm, uint64_t key);
 const struct hmap_entry *ngli_hmap_next(const struct hmap *hm,
                                         const struct hmap_entry *prev);
 void ngli_hmap_freep(struct hmap **hmp);
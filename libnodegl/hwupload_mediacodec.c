@@ -28,6 +28,7 @@
 
 #include "android_surface.h"
 #include "format.h"
+#include "gctx.h"
 #include "glincludes.h"
 #include "hwupload.h"
 #include "image.h"
@@ -76,6 +77,7 @@ static int mc_init(struct ngl_node *node, struct sxplayer_frame *frame)
     ngli_glTexParameteri(gl, target, GL_TEXTURE_MIN_FILTER, min_filter);
     ngli_glTexParameteri(gl, target, GL_TEXTURE_MAG_FILTER, mag_filter);
     ngli_glBindTexture(gl, target, 0);
+    ngli_gctx_invalidate_active_texture(ctx);
 
     struct image_params image_params = {
         .width = frame->width,
@@ -107,6 +109,8 @@ static int mc_map_frame(struct ngl_node *node, struct sxplayer_frame *frame)
 
     float *matrix = hwupload->mapped_image.coordinates_matrix;
     ngli_android_surface_render_buffer(media->android_surface, buffer, matrix);
+    /* SurfaceTexture.updateTexImage() binds the texture on the active unit */
+    ngli_gctx_invalidate_active_texture(node->ctx);
     ngli_mat4_mul(matrix, matrix, flip_matrix);
 
     ngli_texture_set_dimensions(&media->android_texture, frame->width, frame->height, 0);
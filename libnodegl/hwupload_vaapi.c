@@ -29,6 +29,7 @@
 #include <va/va_drmcommon.h>
 
 #include "egl.h"
+#include "gctx.h"
 #include "glincludes.h"
 #include "hwupload.h"
 #include "image.h"
@@ -247,6 +248,7 @@ static int vaapi_map_frame(struct ngl_node *node, struct sxplayer_frame *frame)
 
         ngli_glBindTexture(gl, plane->target, plane->id);
         ngli_glEGLImageTargetTexture2DOES(gl, plane->target, vaapi->egl_images[i]);
+        ngli_gctx_invalidate_active_texture(ctx);
     }
 
     return 0;
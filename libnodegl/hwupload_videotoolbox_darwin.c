@@ -29,6 +29,7 @@
 #include <OpenGL/CGLIOSurface.h>
 
 #include "format.h"
+#include "gctx.h"
 #include "glincludes.h"
 #include "hwupload.h"
 #include "image.h"
@@ -84,6 +85,7 @@ static int vt_darwin_map_frame(struct ngl_node *node, struct sxplayer_frame *fra
         }
 
         ngli_glBindTexture(gl, GL_TEXTURE_RECTANGLE, 0);
+        ngli_gctx_invalidate_active_texture(ctx);
     }
 
     return 0;
@@ -27,6 +27,7 @@
 #include <CoreVideo/CoreVideo.h>
 
 #include "format.h"
+#include "gctx.h"
 #include "glincludes.h"
 #include "hwupload.h"
 #include "image.h"
@@ -51,6 +52,19 @@ struct hwupload_vt_ios {
     CVOpenGLESTextureRef ios_textures[2];
 };
 
+/*
+ * Releasing the CoreVideo texture deletes its GL texture, whose name is
+ * likely to be handed back by the texture cache for the next frame: the
+ * texture bindings recorded by the context must be forgotten beforehand.
+ */
+static void release_ios_texture(struct ngl_ctx *ctx, CVOpenGLESTextureRef *texturep)
+{
+    if (!*texturep)
+        return;
+    ngli_gctx_invalidate_texture(ctx, CVOpenGLESTextureGetName(*texturep));
+    NGLI_CFRELEASE(*texturep);
+}
+
 struct format_desc {
     int layout;
     int nb_planes;
@@ -95,7 +109,7 @@ static int vt_ios_map_plane(struct ngl_node *node, CVPixelBufferRef cvpixbuf, in
     struct texture *plane = &vt->planes[index];
     const struct texture_params *plane_params = &plane->params;
 
-    NGLI_CFRELEASE(vt->ios_textures[index]);
+    release_ios_texture(ctx, &vt->ios_textures[index]);
 
     int width  = CVPixelBufferGetWidthOfPlane(cvpixbuf, index);
     int height = CVPixelBufferGetHeightOfPlane(cvpixbuf, index);
@@ -131,6 +145,7 @@ static int vt_ios_map_plane(struct ngl_node *node, CVPixelBufferRef cvpixbuf, in
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, wrap_s);
     ngli_glTexParameteri(gl, GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, wrap_t);
     ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
+    ngli_gctx_invalidate_active_texture(ctx);
 
     ngli_texture_set_id(plane, id);
     ngli_texture_set_dimensions(plane, width, height, 0);
@@ -177,6 +192,7 @@ static int vt_ios_map_frame(struct ngl_node *node, struct sxplayer_frame *frame)
 
 static void vt_ios_uninit(struct ngl_node *node)
 {
+    struct ngl_ctx *ctx = node->ctx;
     struct texture_priv *s = node->priv_data;
     struct hwupload *hwupload = &s->hwupload;
     struct hwupload_vt_ios *vt = hwupload->hwmap_priv_data;
@@ -184,8 +200,8 @@ static void vt_ios_uninit(struct ngl_node *node)
     ngli_texture_reset(&vt->planes[0]);
     ngli_texture_reset(&vt->planes[1]);
 
-    NGLI_CFRELEASE(vt->ios_textures[0]);
-    NGLI_CFRELEASE(vt->ios_textures[1]);
+    release_ios_texture(ctx, &vt->ios_textures[0]);
+    release_ios_texture(ctx, &vt->ios_textures[1]);
 }
 
 static int support_direct_rendering(struct ngl_node *node, struct sxplayer_frame *frame)
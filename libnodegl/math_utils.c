@@ -267,6 +267,13 @@ void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v)
     memcpy(dst, tmp, sizeof(tmp));
 }
 
+void ngli_mix_floats_c(float *dst, const float *v1, const float *v2, float c, int n)
+{
+    const float d = 1.f - c;
+    for (int i = 0; i < n; i++)
+        dst[i] = v1[i]*d + v2[i]*c;
+}
+
 void ngli_mat4_look_at(float *dst, float *eye, float *center, float *up)
 {
     float f[3];
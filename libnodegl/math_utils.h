@@ -59,6 +59,7 @@ void ngli_mat3_inverse(float *dst, const float *m);
 void ngli_mat4_identity(float *dst);
 void ngli_mat4_mul_c(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_c(float *dst, const float *m, const float *v);
+void ngli_mix_floats_c(float *dst, const float *v1, const float *v2, float c, int n);
 void ngli_mat4_look_at(float *dst, float *eye, float *center, float *up);
 void ngli_mat4_orthographic(float *dst, float left, float right, float bottom, float top, float near, float far);
 void ngli_mat4_perspective(float *dst, float fov, float aspect, float near, float far);
@@ -72,13 +73,22 @@ void ngli_mat4_scale(float *dst, float x, float y, float z);
 #ifdef ARCH_AARCH64
 # define ngli_mat4_mul          ngli_mat4_mul_aarch64
 # define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_aarch64
+# define ngli_mix_floats        ngli_mix_floats_c
+#elif defined(ARCH_X86_64)
+# define ngli_mat4_mul          ngli_mat4_mul_x86_64
+# define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_x86_64
+# define ngli_mix_floats        ngli_mix_floats_x86_64
 #else
 # define ngli_mat4_mul          ngli_mat4_mul_c
 # define ngli_mat4_mul_vec4     ngli_mat4_mul_vec4_c
+# define ngli_mix_floats        ngli_mix_floats_c
 #endif
 
 void ngli_mat4_mul_aarch64(float *dst, const float *m1, const float *m2);
 void ngli_mat4_mul_vec4_aarch64(float *dst, const float *m, const float *v);
+void ngli_mat4_mul_x86_64(float *dst, const float *m1, const float *m2);
+void ngli_mat4_mul_vec4_x86_64(float *dst, const float *m, const float *v);
+void ngli_mix_floats_x86_64(float *dst, const float *v1, const float *v2, float c, int n);
 
 void ngli_quat_slerp(float *dst, const float *q1, const float *q2, float t);
 
@@ -43,13 +43,10 @@ static void mix_buffer(void *user_arg, void *dst,
                        const struct animkeyframe_priv *kf1,
                        double ratio)
 {
-    float *dstf = dst;
     const struct buffer_priv *s = user_arg;
     const float *d1 = (const float *)kf0->data;
     const float *d2 = (const float *)kf1->data;
-    for (int k = 0; k < s->count; k++)
-        for (int i = 0; i < s->data_comp; i++)
-            dstf[k*s->data_comp + i] = NGLI_MIX(d1[k*s->data_comp + i], d2[k*s->data_comp + i], ratio);
+    ngli_mix_floats(dst, d1, d2, ratio, s->count * s->data_comp);
 }
 
 static void cpy_buffer(void *user_arg, void *dst,
@@ -103,7 +103,7 @@ int ngli_node_block_ref(struct ngl_node *node)
         if (ret < 0)
             return ret;
 
-        ret = ngli_buffer_upload(&s->buffer, s->data, s->data_size);
+        ret = ngli_buffer_upload(&s->buffer, s->data, 0, s->data_size);
         if (ret < 0)
             return ret;
 
@@ -122,12 +122,50 @@ void ngli_node_block_unref(struct ngl_node *node)
         ngli_buffer_reset(&s->buffer);
 }
 
+/*
+ * Changed fields separated by less than this number of bytes (typically the
+ * layout padding) are merged into a single upload range.
+ */
+#define UPLOAD_RANGE_MERGE_GAP 16
+
+static int upload_changed_fields(struct block_priv *s)
+{
+    int start = -1;
+    int end = -1;
+
+    for (int i = 0; i < s->nb_fields; i++) {
+        struct block_field_info *fi = &s->field_info[i];
+        if (!fi->has_changed)
+            continue;
+        fi->has_changed = 0;
+
+        const int field_end = fi->offset + fi->size;
+        if (start >= 0 && fi->offset - end < UPLOAD_RANGE_MERGE_GAP) {
+            end = field_end;
+            continue;
+        }
+
+        if (start >= 0) {
+            int ret = ngli_buffer_upload(&s->buffer, s->data + start, start, end - start);
+            if (ret < 0)
+                return ret;
+        }
+        start = fi->offset;
+        end = field_end;
+    }
+
+    if (start >= 0)
+        return ngli_buffer_upload(&s->buffer, s->data + start, start, end - start);
+
+    return 0;
+}
+
 int ngli_node_block_upload(struct ngl_node *node)
 {
     struct block_priv *s = node->priv_data;
 
     if (s->has_changed && s->buffer_last_upload_time != node->last_update_time) {
-        int ret = ngli_buffer_upload(&s->buffer, s->data, s->data_size);
+        int ret = upload_changed_fields(s);
         if (ret < 0)
             return ret;
         s->buffer_last_upload_time = node->last_update_time;
@@ -271,11 +309,12 @@ static void update_block_data(struct block_priv *s, int forced)
 {
     for (int i = 0; i < s->nb_fields; i++) {
         const struct ngl_node *field_node = s->fields[i];
-        const struct block_field_info *fi = &s->field_info[i];
+        struct block_field_info *fi = &s->field_info[i];
         if (!forced && !field_funcs[fi->is_array ? IS_ARRAY : IS_SINGLE].has_changed(field_node))
             continue;
         field_funcs[fi->is_array ? IS_ARRAY : IS_SINGLE].update_data(s->data + fi->offset, field_node, fi);
-        s->has_changed = 1; // TODO: only re-upload the changing data segments
+        fi->has_changed = 1;
+        s->has_changed = 1;
     }
 }
 
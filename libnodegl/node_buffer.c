@@ -22,6 +22,9 @@
 #include <fcntl.h>
 #include <stddef.h>
 #include <stdlib.h>
+#if !defined(TARGET_MINGW_W64)
+#include <sys/mman.h>
+#endif
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <unistd.h>
@@ -49,6 +52,96 @@ static const struct node_param buffer_params[] = {
     {NULL}
 };
 
+/*
+ * The file content is mapped instead of being read into an intermediate
+ * allocation, so the upload and the CPU consumers read directly from the page
+ * cache. The mapping is read-only and private: the file can never be altered
+ * through it. MinGW-w64 has no mmap(), so the content is read there instead.
+ */
+static int map_file_data(struct buffer_priv *s, int fd)
+{
+    if (!s->data_size)
+        return 0;
+
+#if defined(TARGET_MINGW_W64)
+    s->data = ngli_malloc(s->data_size);
+    if (!s->data)
+        return NGL_ERROR_MEMORY;
+
+    ssize_t n = read(fd, s->data, s->data_size);
+    if (n != s->data_size) {
+        if (n < 0)
+            LOG(ERROR, "could not read '%s': %zd", s->filename, n);
+        else
+            LOG(ERROR, "read %zd bytes does not match expected size of %d bytes", n, s->data_size);
+        ngli_free(s->data);
+        s->data = NULL;
+        return NGL_ERROR_IO;
+    }
+#else
+    void *data = mmap(NULL, s->data_size, PROT_READ, MAP_PRIVATE, fd, 0);
+    if (data == MAP_FAILED) {
+        LOG(ERROR, "could not map '%s'", s->filename);
+        return NGL_ERROR_IO;
+    }
+    s->data = data;
+#endif
+
+    return 0;
+}
+
+static void unmap_file_data(struct buffer_priv *s)
+{
+    if (!s->data)
+        return;
+
+#if defined(TARGET_MINGW_W64)
+    ngli_free(s->data);
+#else
+    if (munmap(s->data, s->data_size) < 0)
+        LOG(ERROR, "could not properly unmap '%s'", s->filename);
+#endif
+    s->data = NULL;
+}
+
+static int open_file(struct buffer_priv *s, int *sizep)
+{
+    int fd = open(s->filename, O_RDONLY);
+    if (fd < 0) {
+        LOG(ERROR, "could not open '%s'", s->filename);
+        return NGL_ERROR_IO;
+    }
+
+    struct stat st;
+    if (fstat(fd, &st) < 0) {
+        LOG(ERROR, "could not stat '%s'", s->filename);
+        close(fd);
+        return NGL_ERROR_IO;
+    }
+
+    *sizep = st.st_size;
+    return fd;
+}
+
+/* Map the file again after the mapping was released by a previous upload */
+static int remap_file_data(struct buffer_priv *s)
+{
+    int size;
+    int fd = open_file(s, &size);
+    if (fd < 0)
+        return fd;
+
+    if (size != s->data_size) {
+        LOG(ERROR, "size of '%s' changed from %d to %d bytes", s->filename, s->data_size, size);
+        close(fd);
+        return NGL_ERROR_INVALID_DATA;
+    }
+
+    int ret = map_file_data(s, fd);
+    close(fd);
+    return ret;
+}
+
 int ngli_node_buffer_ref(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -58,20 +151,43 @@ int ngli_node_buffer_ref(struct ngl_node *node)
         return ngli_node_block_ref(s->block);
 
     if (s->buffer_refcount++ == 0) {
+        if (s->filename && !s->data) {
+            int ret = remap_file_data(s);
+            if (ret < 0)
+                return ret;
+        }
+
         int ret = ngli_buffer_init(&s->buffer, ctx, s->data_size, s->usage);
         if (ret < 0)
             return ret;
 
-        ret = ngli_buffer_upload(&s->buffer, s->data, s->data_size);
+        ret = ngli_buffer_upload(&s->buffer, s->data, 0, s->data_size);
         if (ret < 0)
             return ret;
 
+        /* Once uploaded, the file content is only needed by CPU consumers */
+        if (s->filename && !s->keep_data)
+            unmap_file_data(s);
+
         s->buffer_last_upload_time = -1.;
     }
 
     return 0;
 }
 
+void ngli_node_buffer_keep_data(struct ngl_node *node)
+{
+    struct buffer_priv *s = node->priv_data;
+
+    if (s->block) {
+        const struct block_priv *block = s->block->priv_data;
+        ngli_node_buffer_keep_data(block->fields[s->block_field]);
+        return;
+    }
+
+    s->keep_data = 1;
+}
+
 void ngli_node_buffer_unref(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
@@ -92,7 +208,7 @@ int ngli_node_buffer_upload(struct ngl_node *node)
         return ngli_node_block_upload(s->block);
 
     if (s->dynamic && s->buffer_last_upload_time != node->last_update_time) {
-        int ret = ngli_buffer_upload(&s->buffer, s->data, s->data_size);
+        int ret = ngli_buffer_upload(&s->buffer, s->data, 0, s->data_size);
         if (ret < 0)
             return ret;
         s->buffer_last_upload_time = node->last_update_time;
@@ -122,19 +238,10 @@ static int buffer_init_from_filename(struct ngl_node *node)
 {
     struct buffer_priv *s = node->priv_data;
 
-    s->fd = open(s->filename, O_RDONLY);
-    if (s->fd < 0) {
-        LOG(ERROR, "could not open '%s'", s->filename);
-        return NGL_ERROR_IO;
-    }
+    int fd = open_file(s, &s->data_size);
+    if (fd < 0)
+        return fd;
 
-    off_t filesize = lseek(s->fd, 0, SEEK_END);
-    off_t ret      = lseek(s->fd, 0, SEEK_SET);
-    if (filesize < 0 || ret < 0) {
-        LOG(ERROR, "could not seek in '%s'", s->filename);
-        return NGL_ERROR_IO;
-    }
-    s->data_size = filesize;
     s->count = s->count ? s->count : s->data_size / s->data_stride;
 
     if (s->data_size != s->count * s->data_stride) {
@@ -143,25 +250,13 @@ static int buffer_init_from_filename(struct ngl_node *node)
             s->count,
             s->data_stride,
             s->data_size);
+        close(fd);
         return NGL_ERROR_INVALID_DATA;
     }
 
-    s->data = ngli_calloc(s->count, s->data_stride);
-    if (!s->data)
-        return NGL_ERROR_MEMORY;
-
-    ssize_t n = read(s->fd, s->data, s->data_size);
-    if (n < 0) {
-        LOG(ERROR, "could not read '%s': %zd", s->filename, n);
-        return NGL_ERROR_IO;
-    }
-
-    if (n != s->data_size) {
-        LOG(ERROR, "read %zd bytes does not match expected size of %d bytes", n, s->data_size);
-        return NGL_ERROR_IO;
-    }
-
-    return 0;
+    int ret = map_file_data(s, fd);
+    close(fd);
+    return ret;
 }
 
 static int buffer_init_from_count(struct ngl_node *node)
@@ -248,16 +343,8 @@ static void buffer_uninit(struct ngl_node *node)
     struct buffer_priv *s = node->priv_data;
 
     if (s->filename) {
-        ngli_free(s->data);
-        s->data = NULL;
+        unmap_file_data(s);
         s->data_size = 0;
-
-        if (s->fd) {
-            int ret = close(s->fd);
-            if (ret < 0) {
-                LOG(ERROR, "could not properly close '%s'", s->filename);
-            }
-        }
     } else if (s->block) {
         /* Prevent the param API to free a non-owned pointer */
         s->data = NULL;
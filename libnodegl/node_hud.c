@@ -250,10 +250,30 @@ struct latency_measure {
     int64_t total_times;
 };
 
+/*
+ * GPU timer queries are read back a few frames after being issued in order to
+ * not stall the pipeline: each timer owns a ring of queries and reports the
+ * most recent result available.
+ */
+#define NB_GPU_QUERIES 4
+
+struct gpu_timer {
+    GLuint queries[NB_GPU_QUERIES];
+    int pending[NB_GPU_QUERIES];
+    int pos;
+    GLuint64 last_time;
+};
+
+enum {
+    GPU_TIMER_UPDATE,
+    GPU_TIMER_DRAW,
+    NB_GPU_TIMERS
+};
+
 struct widget_latency {
     struct latency_measure measures[NB_LATENCY];
 
-    GLuint query;
+    struct gpu_timer gpu_timers[NB_GPU_TIMERS];
     void (*glGenQueries)(const struct glcontext *gl, GLsizei n, GLuint * ids);
     void (*glDeleteQueries)(const struct glcontext *gl, GLsizei n, const GLuint * ids);
     void (*glBeginQuery)(const struct glcontext *gl, GLenum target, GLuint id);
@@ -332,7 +352,8 @@ static int widget_latency_init(struct ngl_node *node, struct widget *widget)
         priv->glGetQueryObjectui64v = (void *)noop;
     }
 
-    priv->glGenQueries(gl, 1, &priv->query);
+    for (int i = 0; i < NB_GPU_TIMERS; i++)
+        priv->glGenQueries(gl, NB_GPU_QUERIES, priv->gpu_timers[i].queries);
 
     ngli_assert(NB_LATENCY == NGLI_ARRAY_NB(priv->measures));
 
@@ -350,11 +371,7 @@ static int widget_latency_init(struct ngl_node *node, struct widget *widget)
 static int track_children_per_types(struct hmap *map, struct ngl_node *node, int node_type)
 {
     if (node->class->id == node_type) {
-        char key[32];
-        int ret = snprintf(key, sizeof(key), "%p", node);
-        if (ret < 0)
-            return ret;
-        ret = ngli_hmap_set(map, key, node);
+        int ret = ngli_hmap_set_u64(map, (uintptr_t)node, node);
         if (ret < 0)
             return ret;
     }
@@ -373,7 +390,7 @@ static int track_children_per_types(struct hmap *map, struct ngl_node *node, int
 static int make_nodes_set(struct ngl_node *scene, struct darray *nodes_list, const int *node_types)
 {
     /* construct a set of the nodes of a given type(s) */
-    struct hmap *nodes_set = ngli_hmap_create();
+    struct hmap *nodes_set = ngli_hmap_create_u64();
     if (!nodes_set)
         return NGL_ERROR_MEMORY;
     for (int n = 0; node_types[n] != -1; n++) {
@@ -440,6 +457,43 @@ static void register_time(struct hud_priv *s, struct latency_measure *m, int64_t
     m->count = NGLI_MIN(m->count + 1, s->measure_window);
 }
 
+static void gpu_timer_begin(struct glcontext *gl, struct widget_latency *priv, struct gpu_timer *timer)
+{
+    const GLuint query = timer->queries[timer->pos];
+
+    /* The GPU is more than NB_GPU_QUERIES frames late, we have no choice but
+     * to wait for the result before re-using the query */
+    if (timer->pending[timer->pos]) {
+        priv->glGetQueryObjectui64v(gl, query, GL_QUERY_RESULT, &timer->last_time);
+        timer->pending[timer->pos] = 0;
+    }
+
+    priv->glBeginQuery(gl, GL_TIME_ELAPSED, query);
+}
+
+static GLuint64 gpu_timer_end(struct glcontext *gl, struct widget_latency *priv, struct gpu_timer *timer)
+{
+    priv->glEndQuery(gl, GL_TIME_ELAPSED);
+    timer->pending[timer->pos] = 1;
+    timer->pos = (timer->pos + 1) % NB_GPU_QUERIES;
+
+    /* Collect the results of the oldest queries, without blocking */
+    for (int i = 0; i < NB_GPU_QUERIES; i++) {
+        const int pos = (timer->pos + i) % NB_GPU_QUERIES;
+        if (!timer->pending[pos])
+            continue;
+        const GLuint query = timer->queries[pos];
+        GLuint64 available = 0;
+        priv->glGetQueryObjectui64v(gl, query, GL_QUERY_RESULT_AVAILABLE, &available);
+        if (!available)
+            break;
+        priv->glGetQueryObjectui64v(gl, query, GL_QUERY_RESULT, &timer->last_time);
+        timer->pending[pos] = 0;
+    }
+
+    return timer->last_time;
+}
+
 static int widget_latency_update(struct ngl_node *node, struct widget *widget, double t)
 {
     int ret;
@@ -456,7 +510,7 @@ static int widget_latency_update(struct ngl_node *node, struct widget *widget, d
                      "in the same graph due to GL limitations");
     } else {
         ctx->timer_active = 1;
-        priv->glBeginQuery(gl, GL_TIME_ELAPSED, priv->query);
+        gpu_timer_begin(gl, priv, &priv->gpu_timers[GPU_TIMER_UPDATE]);
     }
 
     int64_t update_start = ngli_gettime_relative();
@@ -465,8 +519,7 @@ static int widget_latency_update(struct ngl_node *node, struct widget *widget, d
 
     GLuint64 gpu_tupdate = 0;
     if (!timer_active) {
-        priv->glEndQuery(gl, GL_TIME_ELAPSED);
-        priv->glGetQueryObjectui64v(gl, priv->query, GL_QUERY_RESULT, &gpu_tupdate);
+        gpu_tupdate = gpu_timer_end(gl, priv, &priv->gpu_timers[GPU_TIMER_UPDATE]);
         ctx->timer_active = 0;
     }
 
@@ -488,7 +541,7 @@ static void widget_latency_make_stats(struct ngl_node *node, struct widget *widg
     int timer_active = ctx->timer_active;
     if (!timer_active) {
         ctx->timer_active = 1;
-        priv->glBeginQuery(gl, GL_TIME_ELAPSED, priv->query);
+        gpu_timer_begin(gl, priv, &priv->gpu_timers[GPU_TIMER_DRAW]);
     }
 
     const int64_t draw_start = ngli_gettime_relative();
@@ -497,8 +550,7 @@ static void widget_latency_make_stats(struct ngl_node *node, struct widget *widg
 
     GLuint64 gpu_tdraw = 0;
     if (!timer_active) {
-        priv->glEndQuery(gl, GL_TIME_ELAPSED);
-        priv->glGetQueryObjectui64v(gl, priv->query, GL_QUERY_RESULT, &gpu_tdraw);
+        gpu_tdraw = gpu_timer_end(gl, priv, &priv->gpu_timers[GPU_TIMER_DRAW]);
         ctx->timer_active = 0;
     }
 
@@ -885,7 +937,8 @@ static void widget_latency_uninit(struct ngl_node *node, struct widget *widget)
 
     for (int i = 0; i < NB_LATENCY; i++)
         ngli_free(priv->measures[i].times);
-    priv->glDeleteQueries(gl, 1, &priv->query);
+    for (int i = 0; i < NB_GPU_TIMERS; i++)
+        priv->glDeleteQueries(gl, NB_GPU_QUERIES, priv->gpu_timers[i].queries);
 }
 
 static void widget_memory_uninit(struct ngl_node *node, struct widget *widget)
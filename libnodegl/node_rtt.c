@@ -147,7 +147,7 @@ static int create_ms_rendertarget(struct ngl_node *node, int depth_format)
                 goto end;
             }
             attachment_params.format = params->format;
-            ret = ngli_texture_init(ms_texture, ctx, &attachment_params);
+            ret = ngli_texture_init_pooled(ms_texture, ctx, &attachment_params);
             if (ret < 0)
                 goto end;
             if (!ngli_darray_push(&attachments, &ms_texture)) {
@@ -159,7 +159,7 @@ static int create_ms_rendertarget(struct ngl_node *node, int depth_format)
 
     if (depth_format != NGLI_FORMAT_UNDEFINED) {
         attachment_params.format = depth_format;
-        ret = ngli_texture_init(&s->rt_ms_depth, ctx, &attachment_params);
+        ret = ngli_texture_init_pooled(&s->rt_ms_depth, ctx, &attachment_params);
         if (ret < 0)
             goto end;
         struct texture *rt_ms_depth = &s->rt_ms_depth;
@@ -262,7 +262,7 @@ static int rtt_prefetch(struct ngl_node *node)
         if (depth_format != NGLI_FORMAT_UNDEFINED) {
             struct texture *rt_depth = &s->rt_depth;
             attachment_params.format = depth_format;
-            ret = ngli_texture_init(rt_depth, ctx, &attachment_params);
+            ret = ngli_texture_init_pooled(rt_depth, ctx, &attachment_params);
             if (ret < 0)
                 goto end;
             if (!ngli_darray_push(&attachments, &rt_depth)) {
@@ -375,11 +375,14 @@ static void rtt_draw(struct ngl_node *node)
     if (s->use_clear_color)
         ngli_gctx_set_clear_color(ctx, prev_clear_color);
 
+    /* Mip levels are regenerated lazily by the pipeline the first time the
+     * texture is sampled, so multiple renders of the same target (or a
+     * target never sampled) do not pay for it */
     for (int i = 0; i < s->nb_color_textures; i++) {
         struct texture_priv *texture_priv = s->color_textures[i]->priv_data;
         struct texture *texture = &texture_priv->texture;
         if (ngli_texture_has_mipmap(texture))
-            ngli_texture_generate_mipmap(texture);
+            texture->mipmap_dirty = 1;
     }
 }
 
@@ -387,15 +390,17 @@ static void rtt_release(struct ngl_node *node)
 {
     struct rtt_priv *s = node->priv_data;
 
+    /* The render targets must be released before their attachments are
+     * handed back to the texture pool */
     ngli_rendertarget_reset(&s->rt);
-    ngli_texture_reset(&s->rt_depth);
+    ngli_texture_reset_pooled(&s->rt_depth);
 
     ngli_rendertarget_reset(&s->rt_ms);
     struct texture *rt_ms_colors = ngli_darray_data(&s->rt_ms_colors);
     for (int i = 0; i < ngli_darray_count(&s->rt_ms_colors); i++)
-        ngli_texture_reset(&rt_ms_colors[i]);
+        ngli_texture_reset_pooled(&rt_ms_colors[i]);
     ngli_darray_reset(&s->rt_ms_colors);
-    ngli_texture_reset(&s->rt_ms_depth);
+    ngli_texture_reset_pooled(&s->rt_ms_depth);
 }
 
 const struct node_class ngli_rtt_class = {
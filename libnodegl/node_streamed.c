@@ -159,6 +159,10 @@ static int streamed_init(struct ngl_node *node)
         return NGL_ERROR_INVALID_ARG;
     }
 
+    /* Both buffers are read from the CPU at every update */
+    ngli_node_buffer_keep_data(s->timestamps);
+    ngli_node_buffer_keep_data(s->buffer);
+
     return check_timestamps_buffer(node);
 }
 
@@ -48,8 +48,13 @@ struct text_priv {
     int mag_filter;
     int mipmap_filter;
 
-    struct texture texture;
-    struct canvas canvas;
+    struct text_atlas *atlas;
+    float *vertices_data;
+    float *uvcoords_data;
+    int nb_vertices;
+    int max_vertices;
+    int vertices_changed;
+
     struct program program;
     struct buffer vertices;
     struct buffer uvcoords;
@@ -87,13 +92,19 @@ static const struct param_choices halign_choices = {
     }
 };
 
+static int update_text(struct ngl_node *node);
+
 #define OFFSET(x) offsetof(struct text_priv, x)
 static const struct node_param text_params[] = {
-    {"text",         PARAM_TYPE_STR, OFFSET(text), .flags=PARAM_FLAG_CONSTRUCTOR,
+    {"text",         PARAM_TYPE_STR, OFFSET(text),
+                     .flags=PARAM_FLAG_CONSTRUCTOR | PARAM_FLAG_ALLOW_LIVE_CHANGE,
+                     .update_func=update_text,
                      .desc=NGLI_DOCSTRING("text string to rasterize")},
     {"fg_color",     PARAM_TYPE_VEC4, OFFSET(fg_color), {.vec={1.0, 1.0, 1.0, 1.0}},
+                     .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
                      .desc=NGLI_DOCSTRING("foreground text color")},
     {"bg_color",     PARAM_TYPE_VEC4, OFFSET(bg_color), {.vec={0.0, 0.0, 0.0, 0.8}},
+                     .flags=PARAM_FLAG_ALLOW_LIVE_CHANGE,
                      .desc=NGLI_DOCSTRING("background text color")},
     {"box_corner",   PARAM_TYPE_VEC3, OFFSET(box_corner), {.vec={-1.0, -1.0, 0.0}},
                      .desc=NGLI_DOCSTRING("origin coordinates of `box_width` and `box_height` vectors")},
@@ -121,32 +132,165 @@ static const struct node_param text_params[] = {
                      .desc=NGLI_DOCSTRING("rasterized text texture magnification function")},
     {"mipmap_filter", PARAM_TYPE_SELECT, OFFSET(mipmap_filter), {.i64=NGLI_MIPMAP_FILTER_LINEAR},
                       .choices=&ngli_mipmap_filter_choices,
-                      .desc=NGLI_DOCSTRING("rasterized text texture minifying mipmap function")},
+                      .desc=NGLI_DOCSTRING("unused, the glyph atlas has no mipmaps")},
     {NULL}
 };
 
-static void set_canvas_dimensions(struct canvas *canvas, const char *s)
+/*
+ * The glyph atlas holds the 128 characters of the drawutils font in a grid
+ * of ATLAS_COLS x ATLAS_ROWS cells, each with a 1 pixel empty border so
+ * linear filtering does not sample the neighbouring cells. Such a border is
+ * not enough for mipmapping, where the lower levels merge adjacent cells:
+ * the atlas is therefore created without mipmaps. The red channel is the
+ * glyph coverage, used to mix the background and foreground colors. The
+ * cell of the (never printed) NUL character is left empty and is sampled by
+ * the background areas.
+ */
+#define ATLAS_COLS   16
+#define ATLAS_ROWS   8
+#define ATLAS_CELL_W (NGLI_FONT_W + 2)
+#define ATLAS_CELL_H (NGLI_FONT_H + 2)
+#define ATLAS_W      (ATLAS_COLS * ATLAS_CELL_W)
+#define ATLAS_H      (ATLAS_ROWS * ATLAS_CELL_H)
+
+#define VERTICES_PER_QUAD 6
+
+static int atlas_init(struct texture *texture, struct ngl_ctx *ctx, const struct texture_params *params)
+{
+    struct canvas canvas = {.w = ATLAS_W, .h = ATLAS_H};
+    canvas.buf = ngli_calloc(canvas.w * canvas.h, 4);
+    if (!canvas.buf)
+        return NGL_ERROR_MEMORY;
+
+    for (int c = 1; c < ATLAS_COLS * ATLAS_ROWS; c++) {
+        if (c == '\n')
+            continue;
+        const char str[] = {c, 0};
+        const int x = (c % ATLAS_COLS) * ATLAS_CELL_W + 1;
+        const int y = (c / ATLAS_COLS) * ATLAS_CELL_H + 1;
+        ngli_drawutils_print(&canvas, x, y, str, 0xff0000ff);
+    }
+
+    int ret = ngli_texture_init(texture, ctx, params);
+    if (ret >= 0)
+        ret = ngli_texture_upload(texture, canvas.buf, 0);
+    ngli_free(canvas.buf);
+    return ret;
+}
+
+/* One atlas is shared by all the Text nodes of a context using the same
+ * filtering settings (mipmap_filter is ignored, see above) */
+static int atlas_ref(struct text_priv *s, struct ngl_ctx *ctx)
+{
+    const int id = s->min_filter * NGLI_NB_FILTER + s->mag_filter;
+    struct text_atlas *atlas = &ctx->text_atlases[id];
+
+    if (atlas->refcount == 0) {
+        struct texture_params params = NGLI_TEXTURE_PARAM_DEFAULTS;
+        params.width = ATLAS_W;
+        params.height = ATLAS_H;
+        params.format = NGLI_FORMAT_R8G8B8A8_UNORM;
+        params.min_filter = s->min_filter;
+        params.mag_filter = s->mag_filter;
+        int ret = atlas_init(&atlas->texture, ctx, &params);
+        if (ret < 0) {
+            ngli_texture_reset(&atlas->texture);
+            return ret;
+        }
+    }
+
+    atlas->refcount++;
+    s->atlas = atlas;
+    return 0;
+}
+
+static void atlas_unref(struct text_priv *s)
+{
+    struct text_atlas *atlas = s->atlas;
+    if (!atlas)
+        return;
+    if (--atlas->refcount == 0)
+        ngli_texture_reset(&atlas->texture);
+    s->atlas = NULL;
+}
+
+static void get_text_dimensions(const char *s, int *w, int *h, int *nb_glyphs)
 {
-    canvas->w = 0;
-    canvas->h = NGLI_FONT_H;
+    *w = 0;
+    *h = NGLI_FONT_H;
+    *nb_glyphs = 0;
     int cur_w = 0;
     for (int i = 0; s[i]; i++) {
         if (s[i] == '\n') {
             cur_w = 0;
-            canvas->h += NGLI_FONT_H;
+            *h += NGLI_FONT_H;
         } else {
             cur_w += NGLI_FONT_W;
-            canvas->w = NGLI_MAX(canvas->w, cur_w);
+            *w = NGLI_MAX(*w, cur_w);
+            (*nb_glyphs)++;
         }
     }
 }
 
-static int prepare_canvas(struct text_priv *s)
+struct quad_ctx {
+    const struct text_priv *s;
+    float canvas_w, canvas_h;
+    float *pos;
+    float *uvs;
+    int nb_vertices;
+};
+
+/*
+ * Add a quad covering the canvas pixel rectangle (x, y, w, h), mapped on
+ * the atlas rectangle (u, v, uw, vh). The rectangle is clipped to the canvas
+ * boundaries, just like text rasterized in a canvas would be.
+ */
+static void add_quad(struct quad_ctx *q, float x, float y, float w, float h,
+                     float u, float v, float uw, float vh)
 {
-    /* Set canvas dimensions according to text (and user padding settings) */
-    set_canvas_dimensions(&s->canvas, s->text);
-    s->canvas.w += 2 * s->padding;
-    s->canvas.h += 2 * s->padding;
+    const float x0 = NGLI_MAX(x, 0.f);
+    const float y0 = NGLI_MAX(y, 0.f);
+    const float x1 = NGLI_MIN(x + w, q->canvas_w);
+    const float y1 = NGLI_MIN(y + h, q->canvas_h);
+    if (x1 <= x0 || y1 <= y0)
+        return;
+
+    /* Canvas pixel rows go downward while box_height goes upward */
+    const float bx[] = {x0 / q->canvas_w, x1 / q->canvas_w};
+    const float by[] = {1.f - y1 / q->canvas_h, 1.f - y0 / q->canvas_h};
+    const float tu[] = {u + (x0 - x) / w * uw, u + (x1 - x) / w * uw};
+    const float tv[] = {v + (y1 - y) / h * vh, v + (y0 - y) / h * vh};
+    static const int corners[VERTICES_PER_QUAD][2] = {{0, 0}, {1, 0}, {1, 1}, {0, 0}, {1, 1}, {0, 1}};
+
+    const struct text_priv *s = q->s;
+    for (int i = 0; i < VERTICES_PER_QUAD; i++) {
+        const int cx = corners[i][0];
+        const int cy = corners[i][1];
+        for (int k = 0; k < 3; k++)
+            q->pos[k] = s->box_corner[k] + s->box_width[k] * bx[cx] + s->box_height[k] * by[cy];
+        q->uvs[0] = tu[cx];
+        q->uvs[1] = tv[cy];
+        q->pos += 3;
+        q->uvs += 2;
+    }
+    q->nb_vertices += VERTICES_PER_QUAD;
+}
+
+/* Background areas sample the center of the empty NUL cell */
+static void add_bg_quad(struct quad_ctx *q, float x, float y, float w, float h)
+{
+    const float u = .5f / ATLAS_W;
+    const float v = .5f / ATLAS_H;
+    add_quad(q, x, y, w, h, u, v, (ATLAS_CELL_W - 1.f) / ATLAS_W, (ATLAS_CELL_H - 1.f) / ATLAS_H);
+}
+
+static int build_vertices(struct text_priv *s)
+{
+    /* Canvas dimensions according to text (and user padding settings) */
+    int text_w, text_h, nb_glyphs;
+    get_text_dimensions(s->text, &text_w, &text_h, &nb_glyphs);
+    int canvas_w = text_w + 2 * s->padding;
+    int canvas_h = text_h + 2 * s->padding;
 
     /* Pad it to match container ratio */
     const float box_width_len  = ngli_vec3_length(s->box_width);
@@ -154,17 +298,17 @@ static int prepare_canvas(struct text_priv *s)
     static const int default_ar[2] = {1, 1};
     const int *ar = s->aspect_ratio[1] ? s->aspect_ratio : default_ar;
     const float box_ratio = ar[0] * box_width_len / (float)(ar[1] * box_height_len);
-    const float tex_ratio = s->canvas.w / (float)s->canvas.h;
-    const int aspect_padw = (tex_ratio < box_ratio ? s->canvas.h * box_ratio - s->canvas.w : 0);
-    const int aspect_padh = (tex_ratio < box_ratio ? 0 : s->canvas.w / box_ratio - s->canvas.h);
+    const float tex_ratio = canvas_w / (float)canvas_h;
+    const int aspect_padw = (tex_ratio < box_ratio ? canvas_h * box_ratio - canvas_w : 0);
+    const int aspect_padh = (tex_ratio < box_ratio ? 0 : canvas_w / box_ratio - canvas_h);
 
     /* Adjust canvas size to impact text size */
-    const int texw = (s->canvas.w + aspect_padw) / s->font_scale;
-    const int texh = (s->canvas.h + aspect_padh) / s->font_scale;
-    const int padw = texw - s->canvas.w;
-    const int padh = texh - s->canvas.h;
-    s->canvas.w = NGLI_MAX(1, texw);
-    s->canvas.h = NGLI_MAX(1, texh);
+    const int texw = (canvas_w + aspect_padw) / s->font_scale;
+    const int texh = (canvas_h + aspect_padh) / s->font_scale;
+    const int padw = texw - canvas_w;
+    const int padh = texh - canvas_h;
+    canvas_w = NGLI_MAX(1, texw);
+    canvas_h = NGLI_MAX(1, texh);
 
     /* Adjust text position according to alignment settings */
     const int tx = (s->halign == HALIGN_CENTER ? padw / 2 :
@@ -174,15 +318,60 @@ static int prepare_canvas(struct text_priv *s)
                     s->valign == VALIGN_BOTTOM ? padh     :
                     0) + s->padding;
 
-    /* Allocate, draw background, print text */
-    s->canvas.buf = ngli_calloc(s->canvas.w * s->canvas.h, sizeof(*s->canvas.buf) * 4);
-    if (!s->canvas.buf)
-        return NGL_ERROR_MEMORY;
-    const uint32_t fg = NGLI_COLOR_VEC4_TO_U32(s->fg_color);
-    const uint32_t bg = NGLI_COLOR_VEC4_TO_U32(s->bg_color);
-    struct rect rect = {.w = s->canvas.w, .h = s->canvas.h};
-    ngli_drawutils_draw_rect(&s->canvas, &rect, bg);
-    ngli_drawutils_print(&s->canvas, tx, ty, s->text, fg);
+    /* Worst case: one quad per glyph, one per line end and 4 margins */
+    const int nb_lines = text_h / NGLI_FONT_H;
+    const int max_vertices = (nb_glyphs + nb_lines + 4) * VERTICES_PER_QUAD;
+    if (max_vertices > s->max_vertices) {
+        float *vertices_data = ngli_realloc(s->vertices_data, max_vertices * 3 * sizeof(*vertices_data));
+        if (!vertices_data)
+            return NGL_ERROR_MEMORY;
+        s->vertices_data = vertices_data;
+        float *uvcoords_data = ngli_realloc(s->uvcoords_data, max_vertices * 2 * sizeof(*uvcoords_data));
+        if (!uvcoords_data)
+            return NGL_ERROR_MEMORY;
+        s->uvcoords_data = uvcoords_data;
+    }
+
+    /* The quads do not overlap so the result does not depend on the
+     * blending and depth test configuration */
+    struct quad_ctx q = {
+        .s        = s,
+        .canvas_w = canvas_w,
+        .canvas_h = canvas_h,
+        .pos      = s->vertices_data,
+        .uvs      = s->uvcoords_data,
+    };
+
+    /* Margins around the text */
+    add_bg_quad(&q, 0, 0, canvas_w, ty);
+    add_bg_quad(&q, 0, ty + text_h, canvas_w, canvas_h - ty - text_h);
+    add_bg_quad(&q, 0, ty, tx, text_h);
+    add_bg_quad(&q, tx + text_w, ty, canvas_w - tx - text_w, text_h);
+
+    int px = 0, py = 0;
+    for (int i = 0;; i++) {
+        const char c = s->text[i];
+        if (c == '\n' || !c) {
+            /* Fill the end of the line up to the text width */
+            const int x = tx + px * NGLI_FONT_W;
+            add_bg_quad(&q, x, ty + py * NGLI_FONT_H, tx + text_w - x, NGLI_FONT_H);
+            if (!c)
+                break;
+            py++;
+            px = 0;
+            continue;
+        }
+        const int id = c & 0x7f;
+        add_quad(&q, tx + px * NGLI_FONT_W, ty + py * NGLI_FONT_H, NGLI_FONT_W, NGLI_FONT_H,
+                 ((id % ATLAS_COLS) * ATLAS_CELL_W + 1) / (float)ATLAS_W,
+                 ((id / ATLAS_COLS) * ATLAS_CELL_H + 1) / (float)ATLAS_H,
+                 NGLI_FONT_W / (float)ATLAS_W,
+                 NGLI_FONT_H / (float)ATLAS_H);
+        px++;
+    }
+
+    s->nb_vertices = q.nb_vertices;
+    s->vertices_changed = 1;
     return 0;
 }
 
@@ -204,76 +393,55 @@ static const char * const fragment_data =
     "#version 100"                                                          "\n"
     "precision highp float;"                                                "\n"
     "uniform sampler2D tex;"                                                "\n"
+    "uniform vec4 fg_color;"                                                "\n"
+    "uniform vec4 bg_color;"                                                "\n"
     "varying vec2 var_tex_coord;"                                           "\n"
     "void main(void)"                                                       "\n"
     "{"                                                                     "\n"
-    "    gl_FragColor = texture2D(tex, var_tex_coord);"                     "\n"
+    "    float glyph = texture2D(tex, var_tex_coord).r;"                    "\n"
+    "    gl_FragColor = mix(bg_color, fg_color, glyph);"                    "\n"
     "}";
 
-#define C(index) s->box_corner[index]
-#define W(index) s->box_width[index]
-#define H(index) s->box_height[index]
-
-static int text_init(struct ngl_node *node)
+static int init_pipeline(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
     struct text_priv *s = node->priv_data;
 
-    int ret = prepare_canvas(s);
-    if (ret < 0)
-        return ret;
-
-    const float vertices[] = {
-        C(0),               C(1),               C(2),
-        C(0) + W(0),        C(1) + W(1),        C(2) + W(2),
-        C(0) + H(0) + W(0), C(1) + H(1) + W(1), C(2) + H(2) + W(2),
-        C(0) + H(0),        C(1) + H(1),        C(2) + H(2),
-    };
-
-    static const float uvs[] = {0.0, 1.0, 1.0, 1.0, 1.0, 0.0, 0.0, 0.0};
-
-    ret = ngli_program_init(&s->program, ctx, vertex_data, fragment_data, NULL);
-    if (ret < 0)
-        return ret;
-
-    ret = ngli_buffer_init(&s->vertices, ctx, sizeof(vertices), NGLI_BUFFER_USAGE_STATIC);
-    if (ret < 0)
-        return ret;
-
-    ret = ngli_buffer_upload(&s->vertices, vertices, sizeof(vertices));
-    if (ret < 0)
-        return ret;
-
-    ret = ngli_buffer_init(&s->uvcoords, ctx, sizeof(uvs), NGLI_BUFFER_USAGE_STATIC);
-    if (ret < 0)
-        return ret;
+    ngli_pipeline_reset(&s->pipeline);
+    ngli_buffer_reset(&s->vertices);
+    ngli_buffer_reset(&s->uvcoords);
 
-    ret = ngli_buffer_upload(&s->uvcoords, uvs, sizeof(uvs));
-    if (ret < 0)
-        return ret;
+    /* Leave some room for the text to grow without re-creating the
+     * buffers and the pipeline on every change */
+    s->max_vertices = NGLI_MAX(s->nb_vertices, NGLI_MAX(2 * s->max_vertices, 32 * VERTICES_PER_QUAD));
+    if (s->max_vertices > s->nb_vertices) {
+        float *vertices_data = ngli_realloc(s->vertices_data, s->max_vertices * 3 * sizeof(*vertices_data));
+        if (!vertices_data)
+            return NGL_ERROR_MEMORY;
+        s->vertices_data = vertices_data;
+        float *uvcoords_data = ngli_realloc(s->uvcoords_data, s->max_vertices * 2 * sizeof(*uvcoords_data));
+        if (!uvcoords_data)
+            return NGL_ERROR_MEMORY;
+        s->uvcoords_data = uvcoords_data;
+    }
 
-    struct texture_params tex_params = NGLI_TEXTURE_PARAM_DEFAULTS;
-    tex_params.width = s->canvas.w;
-    tex_params.height = s->canvas.h;
-    tex_params.format = NGLI_FORMAT_R8G8B8A8_UNORM;
-    tex_params.min_filter = s->min_filter;
-    tex_params.mag_filter = s->mag_filter;
-    tex_params.mipmap_filter = s->mipmap_filter;
-    ret = ngli_texture_init(&s->texture, ctx, &tex_params);
+    int ret = ngli_buffer_init(&s->vertices, ctx, s->max_vertices * 3 * sizeof(float), NGLI_BUFFER_USAGE_DYNAMIC);
     if (ret < 0)
         return ret;
 
-    ret = ngli_texture_upload(&s->texture, s->canvas.buf, 0);
+    ret = ngli_buffer_init(&s->uvcoords, ctx, s->max_vertices * 2 * sizeof(float), NGLI_BUFFER_USAGE_DYNAMIC);
     if (ret < 0)
         return ret;
 
     const struct pipeline_uniform uniforms[] = {
         {.name = "modelview_matrix",  .type = NGLI_TYPE_MAT4, .count = 1, .data = NULL},
         {.name = "projection_matrix", .type = NGLI_TYPE_MAT4, .count = 1, .data = NULL},
+        {.name = "fg_color",          .type = NGLI_TYPE_VEC4, .count = 1, .data = s->fg_color},
+        {.name = "bg_color",          .type = NGLI_TYPE_VEC4, .count = 1, .data = s->bg_color},
     };
 
     const struct pipeline_texture textures[] = {
-        {.name  = "tex", .texture = &s->texture},
+        {.name  = "tex", .texture = &s->atlas->texture},
     };
 
     const struct pipeline_attribute attributes[] = {
@@ -291,8 +459,8 @@ static int text_init(struct ngl_node *node)
         .attributes    = attributes,
         .nb_attributes = NGLI_ARRAY_NB(attributes),
         .graphics      = {
-            .topology    = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_FAN,
-            .nb_vertices = 4,
+            .topology    = NGLI_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
+            .nb_vertices = s->nb_vertices,
         }
     };
 
@@ -306,6 +474,70 @@ static int text_init(struct ngl_node *node)
     return 0;
 }
 
+static int upload_vertices(struct ngl_node *node)
+{
+    struct text_priv *s = node->priv_data;
+
+    if (s->nb_vertices > s->max_vertices) {
+        int ret = init_pipeline(node);
+        if (ret < 0)
+            return ret;
+    }
+
+    int ret = ngli_buffer_upload(&s->vertices, s->vertices_data, 0, s->nb_vertices * 3 * sizeof(float));
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_buffer_upload(&s->uvcoords, s->uvcoords_data, 0, s->nb_vertices * 2 * sizeof(float));
+    if (ret < 0)
+        return ret;
+
+    ngli_pipeline_update_nb_vertices(&s->pipeline, s->nb_vertices);
+    s->vertices_changed = 0;
+    return 0;
+}
+
+static int update_text(struct ngl_node *node)
+{
+    /* Live changes are applied from the user thread once the queued draws
+     * are honored: only the CPU side is updated here, the upload happens in
+     * the rendering thread at the next update */
+    struct text_priv *s = node->priv_data;
+    return build_vertices(s);
+}
+
+static int text_init(struct ngl_node *node)
+{
+    struct ngl_ctx *ctx = node->ctx;
+    struct text_priv *s = node->priv_data;
+
+    int ret = atlas_ref(s, ctx);
+    if (ret < 0)
+        return ret;
+
+    ret = build_vertices(s);
+    if (ret < 0)
+        return ret;
+
+    ret = ngli_program_init(&s->program, ctx, vertex_data, fragment_data, NULL);
+    if (ret < 0)
+        return ret;
+
+    ret = init_pipeline(node);
+    if (ret < 0)
+        return ret;
+
+    return upload_vertices(node);
+}
+
+static int text_update(struct ngl_node *node, double t)
+{
+    struct text_priv *s = node->priv_data;
+    if (!s->vertices_changed)
+        return 0;
+    return upload_vertices(node);
+}
+
 static void text_draw(struct ngl_node *node)
 {
     struct ngl_ctx *ctx = node->ctx;
@@ -324,17 +556,22 @@ static void text_uninit(struct ngl_node *node)
 {
     struct text_priv *s = node->priv_data;
     ngli_pipeline_reset(&s->pipeline);
-    ngli_texture_reset(&s->texture);
     ngli_buffer_reset(&s->vertices);
     ngli_buffer_reset(&s->uvcoords);
     ngli_program_reset(&s->program);
-    ngli_free(s->canvas.buf);
+    atlas_unref(s);
+    ngli_free(s->vertices_data);
+    ngli_free(s->uvcoords_data);
+    s->vertices_data = NULL;
+    s->uvcoords_data = NULL;
+    s->nb_vertices = s->max_vertices = 0;
 }
 
 const struct node_class ngli_text_class = {
     .id        = NGL_NODE_TEXT,
     .name      = "Text",
     .init      = text_init,
+    .update    = text_update,
     .draw      = text_draw,
     .uninit    = text_uninit,
     .priv_size = sizeof(struct text_priv),
@@ -463,10 +463,19 @@ static void texture_release(struct ngl_node *node)
     ngli_image_reset(&s->image);
 }
 
+/* Buffer data is uploaded to the texture from the CPU at prefetch and update */
+static void keep_buffer_data(struct ngl_node *node)
+{
+    struct texture_priv *s = node->priv_data;
+    if (s->data_src && s->data_src->class->category == NGLI_NODE_CATEGORY_BUFFER)
+        ngli_node_buffer_keep_data(s->data_src);
+}
+
 static int texture2d_init(struct ngl_node *node)
 {
     struct texture_priv *s = node->priv_data;
     s->supported_image_layouts = s->direct_rendering ? -1 : (1 << NGLI_IMAGE_LAYOUT_DEFAULT);
+    keep_buffer_data(node);
     return 0;
 }
 
@@ -479,6 +488,7 @@ static int texture3d_init(struct ngl_node *node)
         LOG(ERROR, "context does not support 3D textures");
         return NGL_ERROR_UNSUPPORTED;
     }
+    keep_buffer_data(node);
     return 0;
 }
 
@@ -491,6 +501,7 @@ static int texturecube_init(struct ngl_node *node)
         LOG(ERROR, "context does not support cube map textures");
         return NGL_ERROR_UNSUPPORTED;
     }
+    keep_buffer_data(node);
     return 0;
 }
 
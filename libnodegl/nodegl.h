@@ -263,6 +263,9 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
  * @param key       string identifying the parameter
  * @param ...       the value in parameter type
  *
+ * @note if the node is part of the scene of a context, the draws queued with
+ *       ngl_draw_async() are completed before the value is changed
+ *
  * @return 0 on success, NGL_ERROR_* (< 0) on error
  */
 int ngl_node_param_set(struct ngl_node *node, const char *key, ...);
@@ -287,10 +290,26 @@ char *ngl_node_dot(const struct ngl_node *node);
  */
 char *ngl_node_serialize(const struct ngl_node *node);
 
+/**
+ * Serialize in node.gl binary format.
+ *
+ * The binary format is more compact and faster to de-serialize than the
+ * textual one, in particular with large data buffers which are stored
+ * verbatim. It can be de-serialized with ngl_node_deserialize_binary().
+ *
+ * Must be destroyed using free().
+ *
+ * @param node   pointer to the root node of the scene
+ * @param sizep  pointer to the size of the returned buffer (set by the function)
+ *
+ * @return an allocated buffer in node.gl binary format or NULL on error
+ */
+void *ngl_node_serialize_binary(const struct ngl_node *node, int *sizep);
+
 /**
  * De-serialize a scene.
  *
- * @param s  string in node.gl serialized format.
+ * @param s  string in node.gl serialized format
  *
  * Must be destroyed using ngl_node_unrefp().
  *
@@ -298,6 +317,18 @@ char *ngl_node_serialize(const struct ngl_node *node);
  */
 struct ngl_node *ngl_node_deserialize(const char *s);
 
+/**
+ * De-serialize a scene in node.gl binary format.
+ *
+ * @param data  buffer in node.gl binary format
+ * @param size  size of the buffer in bytes; the scene is never read beyond it
+ *
+ * Must be destroyed using ngl_node_unrefp().
+ *
+ * @return a pointer to the de-serialized node graph or NULL on error
+ */
+struct ngl_node *ngl_node_deserialize_binary(const void *data, int size);
+
 /**
  * Platform-specific identifiers
  */
@@ -358,6 +389,15 @@ struct ngl_config {
     uint8_t *capture_buffer; /* RGBA offscreen capture buffer. If allocated,
                                 its size must be at least width * height * 4
                                 bytes. */
+
+    int capture_latency; /* Number of frames the capture is allowed to lag
+                            behind the rendering. If set to a value > 0, the
+                            read back is made asynchronous and capture_buffer
+                            is filled with the frame drawn capture_latency
+                            ngl_draw() calls earlier, leaving it untouched
+                            until enough frames have been drawn. Falls back on
+                            synchronous capture if the context does not
+                            support sync objects and buffer mapping. */
 };
 
 /**
@@ -428,6 +468,37 @@ int ngl_set_scene(struct ngl_ctx *s, struct ngl_node *scene);
  */
 int ngl_draw(struct ngl_ctx *s, double t);
 
+/**
+ * Queue a draw at the specified time and return without waiting for it to
+ * complete.
+ *
+ * The draw is executed in the background by the context thread, allowing the
+ * caller to overlap its own work with the scene visit, update and draw. At
+ * most 2 draws can be pending: if the queue is full, this function blocks
+ * until a slot is available.
+ *
+ * Any other context call (including ngl_draw()) waits for the pending draws
+ * to complete before being executed. The same applies to ngl_node_param_set()
+ * and ngl_node_param_add() when they target a node of the current scene. The
+ * capture buffer, if any, must not be accessed before ngl_wait() has returned.
+ *
+ * @param s     pointer to the configured node.gl context
+ * @param t     target draw time in seconds
+ *
+ * @return 0 on success, NGL_ERROR_* (< 0) if a previously queued draw failed,
+ *         in which case the draw is not queued
+ */
+int ngl_draw_async(struct ngl_ctx *s, double t);
+
+/**
+ * Wait for all the draws queued with ngl_draw_async() to complete.
+ *
+ * @param s     pointer to the node.gl context
+ *
+ * @return 0 on success, NGL_ERROR_* (< 0) if any of the queued draws failed
+ */
+int ngl_wait(struct ngl_ctx *s);
+
 /**
  * Serialize the current scene in Graphviz format (.dot) a node graph at the
  * specified time. Non active nodes will be grayed.
@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <pthread.h>
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
@@ -26,6 +27,7 @@
 #include <stdlib.h>
 #include <string.h>
 
+#include "arena.h"
 #include "hmap.h"
 #include "log.h"
 #include "nodegl.h"
@@ -56,21 +58,39 @@ const struct node_param ngli_base_node_params[] = {
     {NULL}
 };
 
-static void *aligned_allocz(size_t size)
+/*
+ * Nodes (along with their private data) are allocated from a shared arena so
+ * that the nodes of a scene, typically created together, end up contiguous
+ * in memory and cost a pointer increment instead of a system allocation.
+ * Nodes can be created and destroyed from different threads (user and
+ * rendering thread), hence the lock.
+ */
+#define NODE_ARENA_CHUNK_SIZE (64 * 1024)
+
+static pthread_mutex_t node_arena_lock = PTHREAD_MUTEX_INITIALIZER;
+static struct arena node_arena = {.chunk_size = NODE_ARENA_CHUNK_SIZE};
+
+static void *node_alloc(size_t size)
 {
-    void *ptr = ngli_malloc_aligned(size);
-    if (!ptr)
-        return NULL;
-    memset(ptr, 0, size);
+    pthread_mutex_lock(&node_arena_lock);
+    void *ptr = ngli_arena_alloc(&node_arena, size);
+    pthread_mutex_unlock(&node_arena_lock);
     return ptr;
 }
 
+static void node_free(void *ptr)
+{
+    pthread_mutex_lock(&node_arena_lock);
+    ngli_arena_free(&node_arena, ptr);
+    pthread_mutex_unlock(&node_arena_lock);
+}
+
 static struct ngl_node *node_create(const struct node_class *class)
 {
     struct ngl_node *node;
     const size_t node_size = NGLI_ALIGN(sizeof(*node), NGLI_ALIGN_VAL);
 
-    node = aligned_allocz(node_size + class->priv_size);
+    node = node_alloc(node_size + class->priv_size);
     if (!node)
         return NULL;
     node->priv_data = ((uint8_t *)node) + node_size;
@@ -557,6 +577,9 @@ int ngl_node_param_add(struct ngl_node *node, const char *key,
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    if (node->ctx)
+        ngli_wait_queued_draws(node->ctx);
+
     ret = ngli_params_add(base_ptr, par, nb_elems, elems);
     if (ret < 0) {
         LOG(ERROR, "unable to add elements to %s.%s", node->label, key);
@@ -584,6 +607,10 @@ int ngl_node_param_set(struct ngl_node *node, const char *key, ...)
         return NGL_ERROR_INVALID_USAGE;
     }
 
+    /* The rendering thread may still be visiting the graph for queued draws */
+    if (node->ctx)
+        ngli_wait_queued_draws(node->ctx);
+
     va_start(ap, key);
     ret = ngli_params_set(base_ptr, par, &ap);
     va_end(ap);
@@ -617,7 +644,7 @@ void ngl_node_unrefp(struct ngl_node **nodep)
         ngli_assert(!node->ctx);
         ngli_params_free((uint8_t *)node, ngli_base_node_params);
         ngli_params_free(node->priv_data, node->class->params);
-        ngli_free_aligned(node);
+        node_free(node);
     }
     *nodep = NULL;
 }
@@ -61,10 +61,27 @@
 
 struct node_class;
 
+#define NGLI_DRAW_QUEUE_SIZE 2
+
 typedef int (*cmd_func_type)(struct ngl_ctx *s, void *arg);
 
 typedef void (*capture_func_type)(struct ngl_ctx *s);
 
+struct text_atlas {
+    struct texture texture;
+    int refcount;
+};
+
+#define NGLI_NB_TEXT_ATLASES (NGLI_NB_FILTER * NGLI_NB_FILTER)
+
+#define NGLI_MAX_TEXTURE_UNITS 64
+
+struct texture_binding {
+    int known;
+    GLenum target;
+    GLuint id;
+};
+
 struct ngl_ctx {
     /* Controller-only fields */
     const struct backend *backend;
@@ -79,6 +96,13 @@ struct ngl_ctx {
     int viewport[4];
     float clear_color[4];
     int program_id;
+    int active_texture_unit;
+    GLbitfield pending_barriers;
+    struct texture_binding texture_bindings[NGLI_MAX_TEXTURE_UNITS];
+    struct hmap *program_cache;
+    struct hmap *program_uniforms_owners;
+    struct darray texture_pool;
+    struct text_atlas text_atlases[NGLI_NB_TEXT_ATLASES];
     struct ngl_node *scene;
     struct ngl_config config;
     int timer_active;
@@ -101,6 +125,10 @@ struct ngl_ctx {
     struct rendertarget capture_rt;
     struct texture capture_rt_color;
     uint8_t *capture_buffer;
+    GLuint *capture_pbos;
+    GLsync *capture_fences;
+    int nb_capture_pbos;
+    int capture_pbo_index;
 #if defined(TARGET_IPHONE)
     CVPixelBufferRef capture_cvbuffer;
     CVOpenGLESTextureRef capture_cvtexture;
@@ -113,6 +141,10 @@ struct ngl_ctx {
     cmd_func_type cmd_func;
     void *cmd_arg;
     int cmd_ret;
+    double draw_queue[NGLI_DRAW_QUEUE_SIZE];
+    int draw_queue_pos;
+    int nb_queued_draws;
+    int draw_ret;
 };
 
 struct ngl_node {
@@ -193,18 +225,19 @@ struct buffer_priv {
     int nb_animkf;
     struct animation anim;
 
-    int fd;
     int dynamic;
     int data_type;          // any of NGLI_TYPE_*
 
     struct buffer buffer;
     int buffer_refcount;
     double buffer_last_upload_time;
+    int keep_data;          // data is read by the CPU after the GPU upload
 };
 
 int ngli_node_buffer_ref(struct ngl_node *node);
 void ngli_node_buffer_unref(struct ngl_node *node);
 int ngli_node_buffer_upload(struct ngl_node *node);
+void ngli_node_buffer_keep_data(struct ngl_node *node);
 
 struct variable_priv {
     union {
@@ -245,6 +278,7 @@ struct block_field_info {
     int offset;
     int size;
     int stride;
+    int has_changed;
 };
 
 struct block_priv {
@@ -320,6 +354,12 @@ struct timerangemode_priv {
 struct transform_priv {
     struct ngl_node *child;
     NGLI_ALIGNED_MAT(matrix);
+
+    /* Last composed modelview matrix and the inputs it was computed from */
+    NGLI_ALIGNED_MAT(modelview_matrix);
+    NGLI_ALIGNED_MAT(parent_matrix);
+    NGLI_ALIGNED_MAT(local_matrix);
+    int modelview_valid;
 };
 
 struct identity {
@@ -475,6 +515,7 @@ int ngli_node_visit(struct ngl_node *node, int is_active, double t);
 int ngli_node_honor_release_prefetch(struct darray *nodes_array);
 int ngli_node_update(struct ngl_node *node, double t);
 int ngli_prepare_draw(struct ngl_ctx *s, double t);
+void ngli_wait_queued_draws(struct ngl_ctx *s);
 void ngli_node_draw(struct ngl_node *node);
 
 int ngli_node_attach_ctx(struct ngl_node *node, struct ngl_ctx *ctx);
@@ -486,4 +527,19 @@ struct ngl_node *ngli_node_create_noconstructor(int type);
 const struct node_param *ngli_node_param_find(const struct ngl_node *node, const char *key,
                                               uint8_t **base_ptrp);
 
+/*
+ * Binary serialization format, all integers are little-endian:
+ *   header: magic (4 bytes), format version (u32), node.gl version (u32),
+ *           total size including the header (u32), number of nodes (u32)
+ *   nodes:  node type (u32) followed by the non-default parameters, each
+ *           one as a key string, the param type (u32) and the value; an
+ *           empty key ends the list
+ * Strings are stored as a length (u32) and their characters (no trailing
+ * zero), node references as the index of the node (u32), and data
+ * parameters as their size (u32) followed by the raw payload.
+ */
+#define NGLI_SERIALIZE_BIN_MAGIC        "NGLB"
+#define NGLI_SERIALIZE_BIN_VERSION      1
+#define NGLI_SERIALIZE_BIN_HEADER_SIZE  20
+
 #endif
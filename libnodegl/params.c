@@ -498,6 +498,20 @@ int ngli_params_vset(uint8_t *base_ptr, const struct node_param *par, ...)
     return ret;
 }
 
+uint8_t *ngli_params_alloc_data(uint8_t *base_ptr, const struct node_param *par, int size)
+{
+    ngli_assert(par->type == PARAM_TYPE_DATA);
+    uint8_t *dstp = base_ptr + par->offset;
+    uint8_t **dst = (uint8_t **)dstp;
+
+    ngli_free(*dst);
+    *dst = size > 0 ? ngli_malloc(size) : NULL;
+    if (!*dst)
+        size = 0;
+    memcpy(dstp + sizeof(void *), &size, sizeof(size));
+    return *dst;
+}
+
 int ngli_params_set_constructors(uint8_t *base_ptr, const struct node_param *params, va_list *ap)
 {
     if (!params)
@@ -96,6 +96,13 @@ const struct node_param *ngli_params_find(const struct node_param *params, const
 void ngli_params_bstr_print_val(struct bstr *b, uint8_t *base_ptr, const struct node_param *par);
 int ngli_params_set(uint8_t *base_ptr, const struct node_param *par, va_list *ap);
 int ngli_params_vset(uint8_t *base_ptr, const struct node_param *par, ...);
+
+/*
+ * Replace the content of a data parameter with an uninitialized buffer of
+ * the given size and return it, so that it can be filled in place. NULL is
+ * returned (and the parameter left empty) on allocation failure.
+ */
+uint8_t *ngli_params_alloc_data(uint8_t *base_ptr, const struct node_param *par, int size);
 int ngli_params_set_constructors(uint8_t *base_ptr, const struct node_param *params, va_list *ap);
 int ngli_params_set_defaults(uint8_t *base_ptr, const struct node_param *params);
 int ngli_params_add(uint8_t *base_ptr, const struct node_param *par, int nb_elems, void *elems);
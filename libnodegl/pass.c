@@ -61,6 +61,8 @@ static int register_uniform(struct pass *s, const char *name, struct ngl_node *u
 
     if (uniform->class->category == NGLI_NODE_CATEGORY_BUFFER) {
         struct buffer_priv *buffer_priv = uniform->priv_data;
+        /* The pipeline uploads the uniform array from the CPU data */
+        ngli_node_buffer_keep_data(uniform);
         pipeline_uniform.type  = buffer_priv->data_type;
         pipeline_uniform.count = buffer_priv->count;
         pipeline_uniform.data  = buffer_priv->data;
@@ -708,11 +710,15 @@ int ngli_pass_exec(struct pass *s)
     ngli_pipeline_update_uniform(&s->pipeline, s->projection_matrix_index, projection_matrix);
 
     if (s->normal_matrix_index >= 0) {
-        float normal_matrix[3*3];
-        ngli_mat3_from_mat4(normal_matrix, modelview_matrix);
-        ngli_mat3_inverse(normal_matrix, normal_matrix);
-        ngli_mat3_transpose(normal_matrix, normal_matrix);
-        ngli_pipeline_update_uniform(&s->pipeline, s->normal_matrix_index, normal_matrix);
+        if (!s->normal_matrix_valid ||
+            memcmp(s->normal_matrix_modelview, modelview_matrix, sizeof(s->normal_matrix_modelview))) {
+            memcpy(s->normal_matrix_modelview, modelview_matrix, sizeof(s->normal_matrix_modelview));
+            ngli_mat3_from_mat4(s->normal_matrix, modelview_matrix);
+            ngli_mat3_inverse(s->normal_matrix, s->normal_matrix);
+            ngli_mat3_transpose(s->normal_matrix, s->normal_matrix);
+            s->normal_matrix_valid = 1;
+        }
+        ngli_pipeline_update_uniform(&s->pipeline, s->normal_matrix_index, s->normal_matrix);
     }
 
     struct texture_info *texture_infos = ngli_darray_data(&s->texture_infos);
@@ -82,6 +82,11 @@ struct pass {
     int modelview_matrix_index;
     int projection_matrix_index;
     int normal_matrix_index;
+
+    /* Normal matrix along with the modelview matrix it was derived from */
+    int normal_matrix_valid;
+    float normal_matrix_modelview[4*4];
+    float normal_matrix[3*3];
 };
 
 int ngli_pass_init(struct pass *s, struct ngl_ctx *ctx, const struct pass_params *params);
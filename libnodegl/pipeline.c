@@ -19,11 +19,14 @@
  * under the License.
  */
 
+#include <stddef.h>
 #include <string.h>
 
 #include "format.h"
+#include "gctx.h"
 #include "glcontext.h"
 #include "log.h"
+#include "memory.h"
 #include "nodes.h"
 #include "pipeline.h"
 #include "topology.h"
@@ -35,6 +38,9 @@ struct uniform_pair {
     GLuint location;
     struct pipeline_uniform uniform;
     set_uniform_func set;
+    int size;
+    void *shadow;
+    int shadow_valid;
 };
 
 struct texture_pair {
@@ -102,6 +108,17 @@ static const set_uniform_func set_uniform_func_map[NGLI_TYPE_NB] = {
     [NGLI_TYPE_MAT4]  = set_uniform_mat4fv,
 };
 
+static const int uniform_size_map[NGLI_TYPE_NB] = {
+    [NGLI_TYPE_BOOL]  = sizeof(int),
+    [NGLI_TYPE_INT]   = sizeof(int),
+    [NGLI_TYPE_FLOAT] = sizeof(float),
+    [NGLI_TYPE_VEC2]  = sizeof(float) * 2,
+    [NGLI_TYPE_VEC3]  = sizeof(float) * 3,
+    [NGLI_TYPE_VEC4]  = sizeof(float) * 4,
+    [NGLI_TYPE_MAT3]  = sizeof(float) * 3 * 3,
+    [NGLI_TYPE_MAT4]  = sizeof(float) * 4 * 4,
+};
+
 static int build_uniform_pairs(struct pipeline *s, const struct pipeline_params *params)
 {
     const struct program *program = params->program;
@@ -123,29 +140,77 @@ static int build_uniform_pairs(struct pipeline *s, const struct pipeline_params
 
         const set_uniform_func set_func = set_uniform_func_map[uniform->type];
         ngli_assert(set_func);
+        const int size = uniform_size_map[uniform->type] * NGLI_MAX(uniform->count, 1);
         struct uniform_pair pair = {
             .location = info->location,
             .uniform = *uniform,
             .set = set_func,
+            .size = size,
+            .shadow = ngli_calloc(1, size),
         };
-        if (!ngli_darray_push(&s->uniform_pairs, &pair))
+        if (!pair.shadow)
+            return NGL_ERROR_MEMORY;
+        if (!ngli_darray_push(&s->uniform_pairs, &pair)) {
+            ngli_free(pair.shadow);
             return NGL_ERROR_MEMORY;
+        }
     }
 
     return 0;
 }
 
+/*
+ * The uniform values are part of the GL program state, and a program may be
+ * shared with other pipelines through the program cache: the shadow copies
+ * of a pipeline can only be trusted if it was the last one to upload
+ * uniforms to its program.
+ */
+static void claim_program_uniforms(struct pipeline *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    struct hmap *owners = ctx->program_uniforms_owners;
+    const uint64_t program_id = s->program->id;
+
+    if (owners && ngli_hmap_get_u64(owners, program_id) == s)
+        return;
+
+    struct uniform_pair *pairs = ngli_darray_data(&s->uniform_pairs);
+    for (int i = 0; i < ngli_darray_count(&s->uniform_pairs); i++)
+        pairs[i].shadow_valid = 0;
+
+    /* On failure, the shadows are just invalidated again on the next call */
+    if (owners)
+        ngli_hmap_set_u64(owners, program_id, s);
+}
+
+static void upload_uniform(struct glcontext *gl, struct uniform_pair *pair, const void *data)
+{
+    if (pair->shadow_valid && !memcmp(pair->shadow, data, pair->size))
+        return;
+    pair->set(gl, pair->location, pair->uniform.count, data);
+    memcpy(pair->shadow, data, pair->size);
+    pair->shadow_valid = 1;
+}
+
 static void set_uniforms(struct pipeline *s, struct glcontext *gl)
 {
-    const struct uniform_pair *pairs = ngli_darray_data(&s->uniform_pairs);
+    claim_program_uniforms(s);
+
+    struct uniform_pair *pairs = ngli_darray_data(&s->uniform_pairs);
     for (int i = 0; i < ngli_darray_count(&s->uniform_pairs); i++) {
-        const struct uniform_pair *pair = &pairs[i];
+        struct uniform_pair *pair = &pairs[i];
         const struct pipeline_uniform *uniform = &pair->uniform;
         if (uniform->data)
-            pair->set(gl, pair->location, uniform->count, uniform->data);
+            upload_uniform(gl, pair, uniform->data);
     }
 }
 
+static GLbitfield get_texture_barriers(int type)
+{
+    return type == NGLI_TYPE_IMAGE_2D ? GL_SHADER_IMAGE_ACCESS_BARRIER_BIT
+                                      : GL_TEXTURE_FETCH_BARRIER_BIT;
+}
+
 static int build_texture_pairs(struct pipeline *s, const struct pipeline_params *params)
 {
     const struct program *program = params->program;
@@ -175,6 +240,9 @@ static int build_texture_pairs(struct pipeline *s, const struct pipeline_params
             s->used_texture_units |= 1ULL << info->binding;
         }
 
+        if (texture->texture)
+            texture->texture->barriers |= get_texture_barriers(info->type);
+
         struct texture_pair pair = {
             .type     = info->type,
             .location = info->location,
@@ -202,12 +270,13 @@ static int acquire_next_available_texture_unit(uint64_t *texture_units)
 
 static void set_textures(struct pipeline *s, struct glcontext *gl)
 {
+    struct ngl_ctx *ctx = s->ctx;
     uint64_t texture_units = s->used_texture_units;
     const struct texture_pair *pairs = ngli_darray_data(&s->texture_pairs);
     for (int i = 0; i < ngli_darray_count(&s->texture_pairs); i++) {
         const struct texture_pair *pair = &pairs[i];
         const struct pipeline_texture *pipeline_texture = &pair->texture;
-        const struct texture *texture = pipeline_texture->texture;
+        struct texture *texture = pipeline_texture->texture;
 
         if (pair->type == NGLI_TYPE_IMAGE_2D) {
             GLuint texture_id = 0;
@@ -225,15 +294,15 @@ static void set_textures(struct pipeline *s, struct glcontext *gl)
             if (texture_index < 0)
                 return;
             ngli_glUniform1i(gl, pair->location, texture_index);
-            ngli_glActiveTexture(gl, GL_TEXTURE0 + texture_index);
             if (texture) {
-                ngli_glBindTexture(gl, texture->target, texture->id);
+                ngli_gctx_bind_texture(ctx, texture_index, texture->target, texture->id);
+                if (texture->mipmap_dirty) {
+                    ngli_gctx_set_active_texture(ctx, texture_index);
+                    ngli_glGenerateMipmap(gl, texture->target);
+                    texture->mipmap_dirty = 0;
+                }
             } else {
-                ngli_glBindTexture(gl, GL_TEXTURE_2D, 0);
-                if (gl->features & NGLI_FEATURE_TEXTURE_3D)
-                    ngli_glBindTexture(gl, GL_TEXTURE_3D, 0);
-                if (gl->features & NGLI_FEATURE_OES_EGL_EXTERNAL_IMAGE)
-                    ngli_glBindTexture(gl, GL_TEXTURE_EXTERNAL_OES, 0);
+                ngli_gctx_bind_texture(ctx, texture_index, GL_NONE, 0);
             }
         }
     }
@@ -259,7 +328,7 @@ static int build_buffer_pairs(struct pipeline *s, const struct pipeline_params *
 
     for (int i = 0; i < params->nb_buffers; i++) {
         const struct pipeline_buffer *pipeline_buffer = &params->buffers[i];
-        const struct buffer *buffer = pipeline_buffer->buffer;
+        struct buffer *buffer = pipeline_buffer->buffer;
         const struct blockprograminfo *info = ngli_hmap_get(program->buffer_blocks, pipeline_buffer->name);
         if (!info)
             continue;
@@ -273,6 +342,9 @@ static int build_buffer_pairs(struct pipeline *s, const struct pipeline_params *
             return NGL_ERROR_LIMIT_EXCEEDED;
         }
 
+        buffer->barriers |= info->type == NGLI_TYPE_UNIFORM_BUFFER ? GL_UNIFORM_BARRIER_BIT
+                                                                   : GL_SHADER_STORAGE_BARRIER_BIT;
+
         struct buffer_pair pair = {
             .binding = info->binding,
             .type    = ngli_type_get_gl_type(info->type),
@@ -349,6 +421,8 @@ static int build_attribute_pairs(struct pipeline *s, const struct pipeline_param
             return NGL_ERROR_UNSUPPORTED;
         }
 
+        attribute->buffer->barriers |= GL_VERTEX_ATTRIB_ARRAY_BARRIER_BIT;
+
         struct attribute_pair pair = {
             .count     = attribute_count,
             .location  = info->location,
@@ -361,6 +435,43 @@ static int build_attribute_pairs(struct pipeline *s, const struct pipeline_param
     return 0;
 }
 
+/*
+ * Index the pairs by name so the handles can be resolved without scanning
+ * all the pairs; the stored value is the pair index + 1 since a NULL data
+ * would delete the entry. On duplicated names, the first pair wins, like
+ * it would with a linear lookup.
+ */
+static int build_pair_indexes(struct hmap **indexesp, const struct darray *pairs,
+                              size_t name_offset)
+{
+    const int nb_pairs = ngli_darray_count(pairs);
+    struct hmap *indexes = ngli_hmap_create();
+    if (!indexes)
+        return NGL_ERROR_MEMORY;
+    *indexesp = indexes;
+
+    int ret = ngli_hmap_reserve(indexes, nb_pairs);
+    if (ret < 0)
+        return ret;
+
+    for (int i = 0; i < nb_pairs; i++) {
+        const char *name = (const char *)ngli_darray_get(pairs, i) + name_offset;
+        if (ngli_hmap_get(indexes, name))
+            continue;
+        ret = ngli_hmap_set(indexes, name, (void *)(uintptr_t)(i + 1));
+        if (ret < 0)
+            return ret;
+    }
+
+    return 0;
+}
+
+static int get_pair_index(const struct hmap *indexes, const char *name)
+{
+    const uintptr_t index = (uintptr_t)ngli_hmap_get(indexes, name);
+    return index ? (int)index - 1 : NGL_ERROR_NOT_FOUND;
+}
+
 static void use_program(struct pipeline *s, struct glcontext *gl)
 {
     struct ngl_ctx *ctx = s->ctx;
@@ -448,9 +559,7 @@ static void draw_arrays_instanced(const struct pipeline *s, struct glcontext *gl
 static void dispatch_compute(const struct pipeline *s, struct glcontext *gl)
 {
     const struct pipeline_compute *compute = &s->compute;
-    ngli_glMemoryBarrier(gl, GL_ALL_BARRIER_BITS);
     ngli_glDispatchCompute(gl, compute->nb_group_x, compute->nb_group_y, compute->nb_group_z);
-    ngli_glMemoryBarrier(gl, GL_ALL_BARRIER_BITS);
 }
 
 static int pipeline_graphics_init(struct pipeline *s, const struct pipeline_params *params)
@@ -474,10 +583,12 @@ static int pipeline_graphics_init(struct pipeline *s, const struct pipeline_para
         set_vertex_attribs(s, gl);
     }
 
-    if (graphics->indices)
+    if (graphics->indices) {
+        graphics->indices->barriers |= GL_ELEMENT_ARRAY_BARRIER_BIT;
         s->exec = graphics->nb_instances > 0 ? draw_elements_instanced : draw_elements;
-    else
+    } else {
         s->exec = graphics->nb_instances > 0 ? draw_arrays_instanced : draw_arrays;
+    }
 
     return 0;
 }
@@ -528,6 +639,12 @@ int ngli_pipeline_init(struct pipeline *s, struct ngl_ctx *ctx, const struct pip
         (ret = build_buffer_pairs(s, params)) < 0)
         return ret;
 
+    if ((ret = build_pair_indexes(&s->uniform_indexes, &s->uniform_pairs,
+                                  offsetof(struct uniform_pair, uniform.name))) < 0 ||
+        (ret = build_pair_indexes(&s->texture_indexes, &s->texture_pairs,
+                                  offsetof(struct texture_pair, texture.name))) < 0)
+        return ret;
+
     if (params->type == NGLI_PIPELINE_TYPE_GRAPHICS) {
         ret = pipeline_graphics_init(s, params);
         if (ret < 0)
@@ -545,26 +662,12 @@ int ngli_pipeline_init(struct pipeline *s, struct ngl_ctx *ctx, const struct pip
 
 int ngli_pipeline_get_uniform_index(struct pipeline *s, const char *name)
 {
-    struct uniform_pair *pairs = ngli_darray_data(&s->uniform_pairs);
-    for (int i = 0; i < ngli_darray_count(&s->uniform_pairs); i++) {
-        struct uniform_pair *pair = &pairs[i];
-        struct pipeline_uniform *uniform = &pair->uniform;
-        if (!strcmp(uniform->name, name))
-            return i;
-    }
-    return NGL_ERROR_NOT_FOUND;
+    return get_pair_index(s->uniform_indexes, name);
 }
 
 int ngli_pipeline_get_texture_index(struct pipeline *s, const char *name)
 {
-    struct texture_pair *pairs = ngli_darray_data(&s->texture_pairs);
-    for (int i = 0; i < ngli_darray_count(&s->texture_pairs); i++) {
-        struct texture_pair *pair = &pairs[i];
-        struct pipeline_texture *pipeline_texture = &pair->texture;
-        if (!strcmp(pipeline_texture->name, name))
-            return i;
-    }
-    return NGL_ERROR_NOT_FOUND;
+    return get_pair_index(s->texture_indexes, name);
 }
 
 int ngli_pipeline_update_uniform(struct pipeline *s, int index, const void *data)
@@ -580,7 +683,8 @@ int ngli_pipeline_update_uniform(struct pipeline *s, int index, const void *data
         struct ngl_ctx *ctx = s->ctx;
         struct glcontext *gl = ctx->glcontext;
         use_program(s, gl);
-        pair->set(gl, pair->location, pipeline_uniform->count, data);
+        claim_program_uniforms(s);
+        upload_uniform(gl, pair, data);
     }
     pipeline_uniform->data = NULL;
 
@@ -594,12 +698,50 @@ int ngli_pipeline_update_texture(struct pipeline *s, int index, struct texture *
 
     ngli_assert(index < ngli_darray_count(&s->texture_pairs));
     struct texture_pair *pairs = ngli_darray_data(&s->texture_pairs);
-    struct pipeline_texture *pipeline_texture = &pairs[index].texture;
+    struct texture_pair *pair = &pairs[index];
+    struct pipeline_texture *pipeline_texture = &pair->texture;
     pipeline_texture->texture = texture;
+    if (texture)
+        texture->barriers |= get_texture_barriers(pair->type);
 
     return 0;
 }
 
+void ngli_pipeline_update_nb_vertices(struct pipeline *s, int nb_vertices)
+{
+    ngli_assert(s->type == NGLI_PIPELINE_TYPE_GRAPHICS);
+    ngli_assert(!s->graphics.indices);
+    s->graphics.nb_vertices = nb_vertices;
+}
+
+/*
+ * Storage buffers and writable images may have been written by the shaders:
+ * the barriers to issue are the ones required by the consumers of these
+ * resources, as recorded by the pipelines using them.
+ */
+static GLbitfield get_write_barriers(const struct pipeline *s)
+{
+    GLbitfield barriers = 0;
+
+    const struct buffer_pair *buffer_pairs = ngli_darray_data(&s->buffer_pairs);
+    for (int i = 0; i < ngli_darray_count(&s->buffer_pairs); i++) {
+        const struct buffer_pair *pair = &buffer_pairs[i];
+        if (pair->type == GL_SHADER_STORAGE_BUFFER)
+            barriers |= pair->buffer.buffer->barriers;
+    }
+
+    const struct texture_pair *texture_pairs = ngli_darray_data(&s->texture_pairs);
+    for (int i = 0; i < ngli_darray_count(&s->texture_pairs); i++) {
+        const struct texture_pair *pair = &texture_pairs[i];
+        const struct texture *texture = pair->texture.texture;
+        if (pair->type == NGLI_TYPE_IMAGE_2D && texture &&
+            (texture->params.access & NGLI_ACCESS_WRITE_BIT))
+            barriers |= texture->barriers;
+    }
+
+    return barriers;
+}
+
 void ngli_pipeline_exec(struct pipeline *s)
 {
     struct ngl_ctx *ctx = s->ctx;
@@ -607,11 +749,17 @@ void ngli_pipeline_exec(struct pipeline *s)
 
     ngli_honor_pending_glstate(ctx);
 
+    ngli_gctx_flush_memory_barriers(ctx);
+
     use_program(s, gl);
     set_uniforms(s, gl);
     set_buffers(s, gl);
     set_textures(s, gl);
     s->exec(s, gl);
+
+    const GLbitfield barriers = get_write_barriers(s);
+    if (barriers)
+        ngli_gctx_memory_barrier(ctx, barriers);
 }
 
 void ngli_pipeline_reset(struct pipeline *s)
@@ -619,10 +767,15 @@ void ngli_pipeline_reset(struct pipeline *s)
     if (!s->ctx)
         return;
 
+    struct uniform_pair *uniform_pairs = ngli_darray_data(&s->uniform_pairs);
+    for (int i = 0; i < ngli_darray_count(&s->uniform_pairs); i++)
+        ngli_free(uniform_pairs[i].shadow);
     ngli_darray_reset(&s->uniform_pairs);
     ngli_darray_reset(&s->texture_pairs);
     ngli_darray_reset(&s->buffer_pairs);
     ngli_darray_reset(&s->attribute_pairs);
+    ngli_hmap_freep(&s->uniform_indexes);
+    ngli_hmap_freep(&s->texture_indexes);
 
     struct ngl_ctx *ctx = s->ctx;
     struct glcontext *gl = ctx->glcontext;
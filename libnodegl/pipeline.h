@@ -24,6 +24,7 @@
 
 #include "buffer.h"
 #include "darray.h"
+#include "hmap.h"
 #include "program.h"
 #include "texture.h"
 
@@ -107,6 +108,8 @@ struct pipeline {
     struct darray texture_pairs;
     struct darray buffer_pairs;
     struct darray attribute_pairs;
+    struct hmap *uniform_indexes;
+    struct hmap *texture_indexes;
 
     void (*exec)(const struct pipeline *s, struct glcontext *gl);
 
@@ -119,6 +122,7 @@ int ngli_pipeline_get_uniform_index(struct pipeline *s, const char *name);
 int ngli_pipeline_get_texture_index(struct pipeline *s, const char *name);
 int ngli_pipeline_update_uniform(struct pipeline *s, int index, const void *value);
 int ngli_pipeline_update_texture(struct pipeline *s, int index, struct texture *texture);
+void ngli_pipeline_update_nb_vertices(struct pipeline *s, int nb_vertices);
 void ngli_pipeline_exec(struct pipeline *s);
 void ngli_pipeline_reset(struct pipeline *s);
 
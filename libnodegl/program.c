@@ -19,6 +19,7 @@
  * under the License.
  */
 
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -28,6 +29,14 @@
 #include "nodes.h"
 #include "program.h"
 #include "type.h"
+#include "utils.h"
+
+struct program_cache_entry {
+    char key[3 * 8 + 1];
+    char *sources[NGLI_PROGRAM_SHADER_NB];
+    struct program program;
+    int refcount;
+};
 
 static int program_check_status(const struct glcontext *gl, GLuint id, GLenum status)
 {
@@ -279,7 +288,7 @@ static struct hmap *program_probe_buffer_blocks(struct glcontext *gl, GLuint pid
     return bmap;
 }
 
-int ngli_program_init(struct program *s, struct ngl_ctx *ctx, const char *vertex, const char *fragment, const char *compute)
+static int program_build(struct program *s, struct ngl_ctx *ctx, const char *vertex, const char *fragment, const char *compute)
 {
     int ret = 0;
     struct {
@@ -340,10 +349,136 @@ fail:
     return ret;
 }
 
+static void free_cache_entry(void *user_arg, void *data)
+{
+    struct program_cache_entry *entry = data;
+    ngli_program_reset(&entry->program);
+    for (int i = 0; i < NGLI_ARRAY_NB(entry->sources); i++)
+        ngli_free(entry->sources[i]);
+    ngli_free(entry);
+}
+
+struct hmap *ngli_program_cache_create(void)
+{
+    struct hmap *cache = ngli_hmap_create();
+    if (!cache)
+        return NULL;
+    ngli_hmap_set_free(cache, free_cache_entry, NULL);
+    return cache;
+}
+
+void ngli_program_cache_freep(struct hmap **cachep)
+{
+    struct hmap *cache = *cachep;
+    if (!cache)
+        return;
+    const int count = ngli_hmap_count(cache);
+    if (count)
+        LOG(WARNING, "%d program(s) still referenced while releasing the cache", count);
+    ngli_hmap_freep(cachep);
+}
+
+static int same_source(const char *a, const char *b)
+{
+    if (!a || !b)
+        return a == b;
+    return !strcmp(a, b);
+}
+
+static int cache_entry_match(const struct program_cache_entry *entry, const char **sources)
+{
+    for (int i = 0; i < NGLI_PROGRAM_SHADER_NB; i++)
+        if (!same_source(entry->sources[i], sources[i]))
+            return 0;
+    return 1;
+}
+
+static int cache_insert(struct hmap *cache, const char *key, struct program *s, const char **sources)
+{
+    struct program_cache_entry *entry = ngli_calloc(1, sizeof(*entry));
+    if (!entry)
+        return NGL_ERROR_MEMORY;
+
+    snprintf(entry->key, sizeof(entry->key), "%s", key);
+    for (int i = 0; i < NGLI_PROGRAM_SHADER_NB; i++) {
+        if (!sources[i])
+            continue;
+        entry->sources[i] = ngli_strdup(sources[i]);
+        if (!entry->sources[i]) {
+            free_cache_entry(NULL, entry);
+            return NGL_ERROR_MEMORY;
+        }
+    }
+
+    int ret = ngli_hmap_set(cache, key, entry);
+    if (ret < 0) {
+        free_cache_entry(NULL, entry);
+        return ret;
+    }
+
+    /* The cache entry owns the GL program and its probed maps; the caller
+     * only holds a reference on it */
+    entry->program = *s;
+    entry->refcount = 1;
+    s->cache_entry = entry;
+    return 0;
+}
+
+int ngli_program_init(struct program *s, struct ngl_ctx *ctx, const char *vertex, const char *fragment, const char *compute)
+{
+    struct hmap *cache = ctx->program_cache;
+    if (!cache)
+        return program_build(s, ctx, vertex, fragment, compute);
+
+    const char *sources[] = {
+        [NGLI_PROGRAM_SHADER_VERT] = vertex,
+        [NGLI_PROGRAM_SHADER_FRAG] = fragment,
+        [NGLI_PROGRAM_SHADER_COMP] = compute,
+    };
+
+    char key[3 * 8 + 1];
+    snprintf(key, sizeof(key), "%08x%08x%08x",
+             vertex   ? ngli_crc32(vertex)   : 0,
+             fragment ? ngli_crc32(fragment) : 0,
+             compute  ? ngli_crc32(compute)  : 0);
+
+    struct program_cache_entry *entry = ngli_hmap_get(cache, key);
+    if (entry) {
+        if (cache_entry_match(entry, sources)) {
+            *s = entry->program;
+            s->cache_entry = entry;
+            entry->refcount++;
+            return 0;
+        }
+        /* Hash collision: build a private program outside the cache */
+        LOG(DEBUG, "program cache collision on key %s", key);
+        return program_build(s, ctx, vertex, fragment, compute);
+    }
+
+    int ret = program_build(s, ctx, vertex, fragment, compute);
+    if (ret < 0)
+        return ret;
+
+    ret = cache_insert(cache, key, s, sources);
+    if (ret < 0) {
+        ngli_program_reset(s);
+        return ret;
+    }
+
+    return 0;
+}
+
 void ngli_program_reset(struct program *s)
 {
     if (!s->ctx)
         return;
+    struct program_cache_entry *entry = s->cache_entry;
+    if (entry) {
+        memset(s, 0, sizeof(*s));
+        if (--entry->refcount == 0)
+            ngli_hmap_set(entry->program.ctx->program_cache, entry->key, NULL);
+        return;
+    }
     ngli_hmap_freep(&s->uniforms);
     ngli_hmap_freep(&s->attributes);
     ngli_hmap_freep(&s->buffer_blocks);
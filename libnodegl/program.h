@@ -52,8 +52,11 @@ enum {
     NGLI_PROGRAM_SHADER_NB
 };
 
+struct program_cache_entry;
+
 struct program {
     struct ngl_ctx *ctx;
+    struct program_cache_entry *cache_entry;
     struct hmap *uniforms;
     struct hmap *attributes;
     struct hmap *buffer_blocks;
@@ -64,4 +67,7 @@ struct program {
 int ngli_program_init(struct program *s, struct ngl_ctx *ctx, const char *vertex, const char *fragment, const char *compute);
 void ngli_program_reset(struct program *s);
 
+struct hmap *ngli_program_cache_create(void);
+void ngli_program_cache_freep(struct hmap **cachep);
+
 #endif
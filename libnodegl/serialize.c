@@ -20,6 +20,7 @@
  */
 
 #include <inttypes.h>
+#include <limits.h>
 #include <string.h>
 
 #include "bstr.h"
@@ -32,33 +33,21 @@
 
 extern const struct node_param ngli_base_node_params[];
 
-static void free_func(void *arg, void *data)
-{
-    ngli_free(data);
-}
-
+/*
+ * The node id is stored directly in the map value, offset by one since a NULL
+ * value means "no entry".
+ */
 static int register_node(struct hmap *nlist,
                           const struct ngl_node *node)
 {
-    char key[32];
-    int ret = snprintf(key, sizeof(key), "%p", node);
-    if (ret < 0)
-        return ret;
-    char *val = ngli_asprintf("%x", ngli_hmap_count(nlist));
-    if (!val)
-        return NGL_ERROR_MEMORY;
-    ret = ngli_hmap_set(nlist, key, val);
-    if (ret < 0)
-        ngli_free(val);
-    return ret;
+    const intptr_t id = ngli_hmap_count(nlist);
+    return ngli_hmap_set_u64(nlist, (uintptr_t)node, (void *)(id + 1));
 }
 
 static int get_node_id(const struct hmap *nlist, const struct ngl_node *node)
 {
-    char key[32];
-    (void)snprintf(key, sizeof(key), "%p", node);
-    const char *val = ngli_hmap_get(nlist, key);
-    return val ? strtol(val, NULL, 16) : -1;
+    const intptr_t val = (intptr_t)ngli_hmap_get_u64(nlist, (uintptr_t)node);
+    return val - 1;
 }
 
 static int get_rel_node_id(const struct hmap *nlist, const struct ngl_node *node)
@@ -361,12 +350,11 @@ static int serialize(struct hmap *nlist,
 char *ngl_node_serialize(const struct ngl_node *node)
 {
     char *s = NULL;
-    struct hmap *nlist = ngli_hmap_create();
+    struct hmap *nlist = ngli_hmap_create_u64();
     struct bstr *b = ngli_bstr_create();
     if (!nlist || !b)
         goto end;
 
-    ngli_hmap_set_free(nlist, free_func, NULL);
     ngli_bstr_print(b, "# Node.GL v%d.%d.%d\n",
                     NODEGL_VERSION_MAJOR, NODEGL_VERSION_MINOR, NODEGL_VERSION_MICRO);
     if (serialize(nlist, b, node) < 0)
@@ -378,3 +366,303 @@ end:
     ngli_bstr_freep(&b);
     return s;
 }
+
+struct bin {
+    uint8_t *data;
+    int size;
+    int capacity;
+    int error;
+};
+
+static void bin_write(struct bin *w, const void *data, int size)
+{
+    if (w->error)
+        return;
+    if (size > w->capacity - w->size) {
+        if (size > INT_MAX / 2 - w->size) {
+            w->error = NGL_ERROR_LIMIT_EXCEEDED;
+            return;
+        }
+        const int new_capacity = (w->size + size) * 2;
+        uint8_t *ptr = ngli_realloc(w->data, new_capacity);
+        if (!ptr) {
+            w->error = NGL_ERROR_MEMORY;
+            return;
+        }
+        w->data = ptr;
+        w->capacity = new_capacity;
+    }
+    memcpy(w->data + w->size, data, size);
+    w->size += size;
+}
+
+static void bin_write_u32(struct bin *w, uint32_t v)
+{
+    const uint8_t b[4] = {v & 0xff, v >> 8 & 0xff, v >> 16 & 0xff, v >> 24};
+    bin_write(w, b, sizeof(b));
+}
+
+static void bin_write_u64(struct bin *w, uint64_t v)
+{
+    bin_write_u32(w, v & 0xffffffff);
+    bin_write_u32(w, v >> 32);
+}
+
+static void bin_write_floats(struct bin *w, int n, const float *f)
+{
+    for (int i = 0; i < n; i++) {
+        const union { uint32_t i; float f; } u = {.f = f[i]};
+        bin_write_u32(w, u.i);
+    }
+}
+
+static void bin_write_doubles(struct bin *w, int n, const double *f)
+{
+    for (int i = 0; i < n; i++) {
+        const union { uint64_t i; double f; } u = {.f = f[i]};
+        bin_write_u64(w, u.i);
+    }
+}
+
+static void bin_write_str(struct bin *w, const char *s)
+{
+    const int len = strlen(s);
+    bin_write_u32(w, len);
+    bin_write(w, s, len);
+}
+
+static int param_is_default(const struct ngl_node *node,
+                            const uint8_t *priv,
+                            const struct node_param *p)
+{
+    const uint8_t *v = priv + p->offset;
+    switch (p->type) {
+        case PARAM_TYPE_SELECT:
+        case PARAM_TYPE_FLAGS:
+        case PARAM_TYPE_BOOL:
+        case PARAM_TYPE_INT:        return *(int *)v == p->def_value.i64;
+        case PARAM_TYPE_I64:        return *(int64_t *)v == p->def_value.i64;
+        case PARAM_TYPE_DBL:        return *(double *)v == p->def_value.dbl;
+        case PARAM_TYPE_RATIONAL:   return !memcmp(v, p->def_value.r, sizeof(p->def_value.r));
+        case PARAM_TYPE_VEC2:
+        case PARAM_TYPE_VEC3:
+        case PARAM_TYPE_VEC4:       return !memcmp(v, p->def_value.vec, (p->type - PARAM_TYPE_VEC2 + 2) * sizeof(float));
+        case PARAM_TYPE_MAT4:       return !memcmp(v, p->def_value.mat, sizeof(p->def_value.mat));
+        case PARAM_TYPE_NODE:       return !*(struct ngl_node **)v;
+        case PARAM_TYPE_NODEDICT:   return !*(struct hmap **)v || !ngli_hmap_count(*(struct hmap **)v);
+        case PARAM_TYPE_NODELIST:
+        case PARAM_TYPE_DBLLIST:    return !*(int *)(v + sizeof(void *));
+        case PARAM_TYPE_DATA:       return !*(uint8_t **)v || !*(int *)(v + sizeof(uint8_t *));
+        case PARAM_TYPE_STR: {
+            const char *s = *(char **)v;
+            return !s || (p->def_value.str && !strcmp(s, p->def_value.str)) ||
+                   (!strcmp(p->key, "label") && ngli_is_default_label(node->class->name, s));
+        }
+    }
+    return 1;
+}
+
+static int serialize_options_bin(struct hmap *nlist,
+                                 struct bin *w,
+                                 const struct ngl_node *node,
+                                 uint8_t *priv,
+                                 const struct node_param *p)
+{
+    while (p && p->key) {
+        if (param_is_default(node, priv, p)) {
+            p++;
+            continue;
+        }
+        bin_write_str(w, p->key);
+        bin_write_u32(w, p->type);
+        const uint8_t *v = priv + p->offset;
+        switch (p->type) {
+            case PARAM_TYPE_SELECT: {
+                const char *s = ngli_params_get_select_str(p->choices->consts, *(int *)v);
+                ngli_assert(s);
+                bin_write_str(w, s);
+                break;
+            }
+            case PARAM_TYPE_FLAGS: {
+                char *s = ngli_params_get_flags_str(p->choices->consts, *(int *)v);
+                if (!s)
+                    return NGL_ERROR_MEMORY;
+                bin_write_str(w, s);
+                ngli_free(s);
+                break;
+            }
+            case PARAM_TYPE_BOOL:
+            case PARAM_TYPE_INT:
+                bin_write_u32(w, *(int *)v);
+                break;
+            case PARAM_TYPE_I64:
+                bin_write_u64(w, *(int64_t *)v);
+                break;
+            case PARAM_TYPE_DBL:
+                bin_write_doubles(w, 1, (double *)v);
+                break;
+            case PARAM_TYPE_RATIONAL:
+                bin_write_u32(w, ((int *)v)[0]);
+                bin_write_u32(w, ((int *)v)[1]);
+                break;
+            case PARAM_TYPE_STR:
+                bin_write_str(w, *(char **)v);
+                break;
+            case PARAM_TYPE_DATA: {
+                const int size = *(int *)(v + sizeof(uint8_t *));
+                bin_write_u32(w, size);
+                bin_write(w, *(uint8_t **)v, size);
+                break;
+            }
+            case PARAM_TYPE_VEC2:
+            case PARAM_TYPE_VEC3:
+            case PARAM_TYPE_VEC4:
+                bin_write_floats(w, p->type - PARAM_TYPE_VEC2 + 2, (float *)v);
+                break;
+            case PARAM_TYPE_MAT4:
+                bin_write_floats(w, 16, (float *)v);
+                break;
+            case PARAM_TYPE_NODE:
+                bin_write_u32(w, get_node_id(nlist, *(struct ngl_node **)v));
+                break;
+            case PARAM_TYPE_NODELIST: {
+                struct ngl_node **nodes = *(struct ngl_node ***)v;
+                const int nb_nodes = *(int *)(v + sizeof(struct ngl_node **));
+                bin_write_u32(w, nb_nodes);
+                for (int i = 0; i < nb_nodes; i++)
+                    bin_write_u32(w, get_node_id(nlist, nodes[i]));
+                break;
+            }
+            case PARAM_TYPE_DBLLIST: {
+                const double *elems = *(double **)v;
+                const int nb_elems = *(int *)(v + sizeof(double *));
+                bin_write_u32(w, nb_elems);
+                bin_write_doubles(w, nb_elems, elems);
+                break;
+            }
+            case PARAM_TYPE_NODEDICT: {
+                struct hmap *hmap = *(struct hmap **)v;
+                bin_write_u32(w, ngli_hmap_count(hmap));
+                const struct hmap_entry *entry = NULL;
+                while ((entry = ngli_hmap_next(hmap, entry))) {
+                    bin_write_str(w, entry->key);
+                    bin_write_u32(w, get_node_id(nlist, entry->data));
+                }
+                break;
+            }
+            default:
+                LOG(ERROR, "cannot serialize %s: unsupported parameter type", p->key);
+                return NGL_ERROR_UNSUPPORTED;
+        }
+        p++;
+    }
+    return 0;
+}
+
+static int serialize_bin(struct hmap *nlist,
+                         struct bin *w,
+                         const struct ngl_node *node);
+
+static int serialize_children_bin(struct hmap *nlist,
+                                  struct bin *w,
+                                  uint8_t *priv,
+                                  const struct node_param *p)
+{
+    while (p && p->key) {
+        switch (p->type) {
+            case PARAM_TYPE_NODE: {
+                const struct ngl_node *child = *(struct ngl_node **)(priv + p->offset);
+                if (child) {
+                    int ret = serialize_bin(nlist, w, child);
+                    if (ret < 0)
+                        return ret;
+                }
+                break;
+            }
+            case PARAM_TYPE_NODELIST: {
+                struct ngl_node **children = *(struct ngl_node ***)(priv + p->offset);
+                const int nb_children = *(int *)(priv + p->offset + sizeof(struct ngl_node **));
+
+                for (int i = 0; i < nb_children; i++) {
+                    int ret = serialize_bin(nlist, w, children[i]);
+                    if (ret < 0)
+                        return ret;
+                }
+                break;
+            }
+            case PARAM_TYPE_NODEDICT: {
+                struct hmap *hmap = *(struct hmap **)(priv + p->offset);
+                if (!hmap)
+                    break;
+                const struct hmap_entry *entry = NULL;
+                while ((entry = ngli_hmap_next(hmap, entry))) {
+                    int ret = serialize_bin(nlist, w, entry->data);
+                    if (ret < 0)
+                        return ret;
+                }
+                break;
+            }
+        }
+        p++;
+    }
+    return 0;
+}
+
+static int serialize_bin(struct hmap *nlist,
+                         struct bin *w,
+                         const struct ngl_node *node)
+{
+    if (get_node_id(nlist, node) >= 0)
+        return 0;
+
+    int ret;
+
+    if ((ret = serialize_children_bin(nlist, w, (uint8_t *)node, ngli_base_node_params)) < 0 ||
+        (ret = serialize_children_bin(nlist, w, node->priv_data, node->class->params)) < 0)
+        return ret;
+
+    bin_write_u32(w, node->class->id);
+    if ((ret = serialize_options_bin(nlist, w, node, node->priv_data, node->class->params)) < 0 ||
+        (ret = serialize_options_bin(nlist, w, node, (uint8_t *)node, ngli_base_node_params)) < 0)
+        return ret;
+    bin_write_u32(w, 0);
+    if (w->error)
+        return w->error;
+
+    return register_node(nlist, node);
+}
+
+void *ngl_node_serialize_binary(const struct ngl_node *node, int *sizep)
+{
+    struct bin w = {0};
+    struct hmap *nlist = ngli_hmap_create_u64();
+    if (!nlist)
+        return NULL;
+
+    bin_write(&w, NGLI_SERIALIZE_BIN_MAGIC, 4);
+    bin_write_u32(&w, NGLI_SERIALIZE_BIN_VERSION);
+    bin_write_u32(&w, NODEGL_VERSION_INT);
+    bin_write_u32(&w, 0); // total size, set once known
+    bin_write_u32(&w, 0); // number of nodes, set once known
+    int ret = serialize_bin(nlist, &w, node);
+    if (ret < 0 || w.error) {
+        ngli_free(w.data);
+        w.data = NULL;
+        goto end;
+    }
+
+    const uint32_t header_fields[] = {w.size, ngli_hmap_count(nlist)};
+    for (int i = 0; i < NGLI_ARRAY_NB(header_fields); i++) {
+        uint8_t *dst = w.data + 12 + i * 4;
+        const uint32_t v = header_fields[i];
+        dst[0] = v & 0xff;
+        dst[1] = v >> 8 & 0xff;
+        dst[2] = v >> 16 & 0xff;
+        dst[3] = v >> 24;
+    }
+    *sizep = w.size;
+
+end:
+    ngli_hmap_freep(&nlist);
+    return w.data;
+}
@@ -0,0 +1,72 @@
+/*
+ * Copyright 2019 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdint.h>
+#include <string.h>
+
+#include "arena.h"
+#include "utils.h"
+
+#define CHUNK_SIZE 256
+
+int main(void)
+{
+    struct arena arena;
+    ngli_arena_init(&arena, CHUNK_SIZE);
+
+    /* Allocations are aligned, zeroed and distinct */
+    uint8_t *ptrs[32];
+    for (int i = 0; i < NGLI_ARRAY_NB(ptrs); i++) {
+        const size_t size = 1 + i * 3;
+        ptrs[i] = ngli_arena_alloc(&arena, size);
+        ngli_assert(ptrs[i]);
+        ngli_assert(((uintptr_t)ptrs[i] & (NGLI_ALIGN_VAL - 1)) == 0);
+        for (int j = 0; j < size; j++)
+            ngli_assert(ptrs[i][j] == 0);
+        memset(ptrs[i], i + 1, size);
+    }
+    for (int i = 0; i < NGLI_ARRAY_NB(ptrs); i++)
+        for (int j = 0; j < 1 + i * 3; j++)
+            ngli_assert(ptrs[i][j] == i + 1);
+
+    /* Allocation larger than a chunk */
+    uint8_t *large = ngli_arena_alloc(&arena, CHUNK_SIZE * 4);
+    ngli_assert(large);
+    memset(large, 0xff, CHUNK_SIZE * 4);
+
+    /* Release in an arbitrary order */
+    for (int i = 0; i < NGLI_ARRAY_NB(ptrs); i += 2)
+        ngli_arena_free(&arena, ptrs[i]);
+    ngli_arena_free(&arena, large);
+    for (int i = 1; i < NGLI_ARRAY_NB(ptrs); i += 2)
+        ngli_arena_free(&arena, ptrs[i]);
+
+    /* The current chunk is recycled once it is empty */
+    uint8_t *p0 = ngli_arena_alloc(&arena, 16);
+    ngli_arena_free(&arena, p0);
+    uint8_t *p1 = ngli_arena_alloc(&arena, 16);
+    ngli_assert(p0 == p1);
+    ngli_arena_free(&arena, p1);
+    ngli_arena_free(&arena, NULL);
+
+    ngli_arena_reset(&arena);
+    return 0;
+}
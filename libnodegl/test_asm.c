@@ -21,6 +21,7 @@
 
 #include <stdlib.h>
 #include <math.h>
+#include <string.h>
 
 #include "utils.h"
 #include "math_utils.h"
@@ -78,6 +79,20 @@ int main(void)
         flt_check(m_diff, 4*4);
     }
 
+    if (ngli_mat4_mul_c != ngli_mat4_mul) {
+        printf(":: Testing mat4 mul in place\n");
+
+        NGLI_ALIGNED_MAT(m_ref);
+        NGLI_ALIGNED_MAT(m_out);
+        NGLI_ALIGNED_MAT(m_diff);
+
+        memcpy(m_out, m2, sizeof(m_out));
+        ngli_mat4_mul_c(m_ref, m1, m2);
+        ngli_mat4_mul(m_out, m1, m_out);
+        flt_diff(m_diff, m_ref, m_out, 4*4);
+        flt_check(m_diff, 4*4);
+    }
+
     if (ngli_mat4_mul_vec4_c != ngli_mat4_mul_vec4) {
         for (int i = 0; i < 4; i++) {
             printf(":: Testing mat4 mul vec4 %d/4\n", i + 1);
@@ -99,5 +114,24 @@ int main(void)
         }
     }
 
+    if (ngli_mix_floats_c != ngli_mix_floats) {
+        /* Odd count to cover the scalar tail */
+        const int n = 4*4 - 1;
+        static const float ratios[] = {0.f, 0.3f, 1.f};
+
+        for (int i = 0; i < NGLI_ARRAY_NB(ratios); i++) {
+            printf(":: Testing mix floats %d/%d\n", i + 1, NGLI_ARRAY_NB(ratios));
+
+            float f_ref[4*4] = {0};
+            float f_out[4*4] = {0};
+            float f_diff[4*4];
+
+            ngli_mix_floats_c(f_ref, m1, m2, ratios[i], n);
+            ngli_mix_floats(f_out, m1, m2, ratios[i], n);
+            flt_diff(f_diff, f_ref, f_out, 4*4);
+            flt_check(f_diff, 4*4);
+        }
+    }
+
     return 0;
 }
@@ -90,5 +90,51 @@ int main(void)
         ngli_hmap_freep(&hm);
     }
 
+    /* Integer keyed map */
+    struct hmap *hm = ngli_hmap_create_u64();
+    ngli_assert(hm);
+    for (int i = 0; i < NGLI_ARRAY_NB(kvs); i++) {
+        const uint64_t key = (uintptr_t)&kvs[i];
+        ngli_assert(ngli_hmap_set_u64(hm, key, (void *)kvs[i].val) >= 0);
+        ngli_assert(ngli_hmap_get_u64(hm, key) == kvs[i].val);
+    }
+    ngli_assert(ngli_hmap_count(hm) == NGLI_ARRAY_NB(kvs));
+    ngli_assert(!ngli_hmap_get_u64(hm, 0));
+    ngli_assert(ngli_hmap_set_u64(hm, (uintptr_t)&kvs[0], RSTR) == 0);
+    ngli_assert(!strcmp(ngli_hmap_get_u64(hm, (uintptr_t)&kvs[0]), RSTR));
+    for (int i = 0; i < NGLI_ARRAY_NB(kvs); i++) {
+        const uint64_t key = (uintptr_t)&kvs[i];
+        ngli_assert(ngli_hmap_set_u64(hm, key, NULL) == 1);
+        ngli_assert(ngli_hmap_set_u64(hm, key, NULL) == 0);
+        ngli_assert(!ngli_hmap_get_u64(hm, key));
+    }
+    ngli_assert(ngli_hmap_count(hm) == 0);
+    ngli_hmap_freep(&hm);
+
+    /* Lookups, deletions and iteration across incremental rehashes */
+    for (int reserve = 0; reserve <= 1; reserve++) {
+        static const int nb_keys = 1000;
+        hm = ngli_hmap_create_u64();
+        ngli_assert(hm);
+        if (reserve)
+            ngli_assert(ngli_hmap_reserve(hm, nb_keys) == 0);
+        for (int i = 0; i < nb_keys; i++) {
+            ngli_assert(ngli_hmap_set_u64(hm, i, (void *)(intptr_t)(i + 1)) == 0);
+            if (i % 3 == 0)
+                ngli_assert(ngli_hmap_set_u64(hm, i / 2, NULL) == 1);
+            for (int j = 0; j <= i; j += 37)
+                ngli_assert(!ngli_hmap_get_u64(hm, j) || ngli_hmap_get_u64(hm, j) == (void *)(intptr_t)(j + 1));
+        }
+        int nb_entries = 0;
+        const struct hmap_entry *e = NULL;
+        while ((e = ngli_hmap_next(hm, e))) {
+            ngli_assert(e->data == (void *)(intptr_t)(e->key_u64 + 1));
+            nb_entries++;
+        }
+        ngli_assert(nb_entries == ngli_hmap_count(hm));
+        printf("u64 map [reserve:%s]: %d entries\n", reserve ? "yes" : "no", nb_entries);
+        ngli_hmap_freep(&hm);
+    }
+
     return 0;
 }
@@ -0,0 +1,143 @@
+/*
+ * Copyright 2026 GoPro Inc.
+ *
+ * Licensed to the Apache Software Foundation (ASF) under one
+ * or more contributor license agreements.  See the NOTICE file
+ * distributed with this work for additional information
+ * regarding copyright ownership.  The ASF licenses this file
+ * to you under the Apache License, Version 2.0 (the
+ * "License"); you may not use this file except in compliance
+ * with the License.  You may obtain a copy of the License at
+ *
+ *   http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing,
+ * software distributed under the License is distributed on an
+ * "AS IS" BASIS, WITHOUT WARRANTIES OR CONDITIONS OF ANY
+ * KIND, either express or implied.  See the License for the
+ * specific language governing permissions and limitations
+ * under the License.
+ */
+
+#include <stdlib.h>
+#include <string.h>
+
+#include "nodegl.h"
+#include "nodes.h"
+#include "utils.h"
+
+/* Build a scene covering every parameter type used by the nodes */
+static struct ngl_node *create_scene(void)
+{
+    static const float data[] = {0.f, 0.5f, -1.f, 1e-7f, 3.25f, 42.f};
+    static const float mat[] = {
+        1.f, 2.f, 3.f, 4.f,
+        5.f, 6.f, 7.f, 8.f,
+        9.f, 10.f, 11.f, 12.f,
+        13.f, 14.f, 15.f, 16.f,
+    };
+    static const double easing_args[] = {0.25, 1.5};
+
+    struct ngl_node *quad = ngl_node_create(NGL_NODE_QUAD);
+    ngl_node_param_set(quad, "corner", (const float[3]){-1.f, -1.f, 0.5f});
+
+    struct ngl_node *program = ngl_node_create(NGL_NODE_PROGRAM);
+    ngl_node_param_set(program, "fragment", "void main() {}\n% \"escaped\"\t");
+
+    struct ngl_node *buffer = ngl_node_create(NGL_NODE_BUFFERFLOAT);
+    ngl_node_param_set(buffer, "data", (int)sizeof(data), data);
+
+    struct ngl_node *umat = ngl_node_create(NGL_NODE_UNIFORMMAT4);
+    ngl_node_param_set(umat, "value", mat);
+
+    struct ngl_node *kfs[] = {
+        ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT, 0.0, 1.0),
+        ngl_node_create(NGL_NODE_ANIMKEYFRAMEFLOAT, 2.5, -3.0),
+    };
+    ngl_node_param_set(kfs[1], "easing", "exp_in");
+    ngl_node_param_add(kfs[1], "easing_args", NGLI_ARRAY_NB(easing_args), (void *)easing_args);
+    struct ngl_node *anim = ngl_node_create(NGL_NODE_ANIMATEDFLOAT);
+    ngl_node_param_add(anim, "keyframes", NGLI_ARRAY_NB(kfs), kfs);
+
+    struct ngl_node *render = ngl_node_create(NGL_NODE_RENDER, quad);
+    ngl_node_param_set(render, "label", "render label");
+    ngl_node_param_set(render, "program", program);
+    ngl_node_param_set(render, "nb_instances", 3);
+    ngl_node_param_set(render, "attributes", "buf", buffer);
+    ngl_node_param_set(render, "uniforms", "mat", umat);
+    ngl_node_param_set(render, "uniforms", "anim", anim);
+
+    struct ngl_node *config = ngl_node_create(NGL_NODE_GRAPHICCONFIG, render);
+    ngl_node_param_set(config, "blend", 1);
+    ngl_node_param_set(config, "color_write_mask", "r+b");
+
+    struct ngl_node *transform = ngl_node_create(NGL_NODE_TRANSFORM, config);
+    ngl_node_param_set(transform, "matrix", mat);
+
+    struct ngl_node *camera = ngl_node_create(NGL_NODE_CAMERA, render);
+    ngl_node_param_set(camera, "perspective", (const float[2]){45.f, 1.5f});
+    ngl_node_param_set(camera, "orthographic", (const float[4]){-1.f, 1.f, -2.f, 2.f});
+
+    struct ngl_node *hud = ngl_node_create(NGL_NODE_HUD, camera);
+    ngl_node_param_set(hud, "refresh_rate", 1, 3);
+
+    struct ngl_node *group = ngl_node_create(NGL_NODE_GROUP);
+    struct ngl_node *children[] = {transform, hud, render};
+    ngl_node_param_add(group, "children", NGLI_ARRAY_NB(children), children);
+
+    struct ngl_node *nodes[] = {quad, program, buffer, umat, kfs[0], kfs[1], anim,
+                                render, config, transform, camera, hud};
+    for (int i = 0; i < NGLI_ARRAY_NB(nodes); i++)
+        ngl_node_unrefp(&nodes[i]);
+
+    return group;
+}
+
+int main(void)
+{
+    struct ngl_node *scene = create_scene();
+    ngli_assert(scene);
+
+    char *ref = ngl_node_serialize(scene);
+    ngli_assert(ref);
+
+    /* Text format round trip */
+    struct ngl_node *text_scene = ngl_node_deserialize(ref);
+    ngli_assert(text_scene);
+    char *text_str = ngl_node_serialize(text_scene);
+    ngli_assert(text_str && !strcmp(ref, text_str));
+
+    /* Binary format round trip */
+    int size;
+    uint8_t *bin = ngl_node_serialize_binary(scene, &size);
+    ngli_assert(bin && size >= NGLI_SERIALIZE_BIN_HEADER_SIZE);
+    struct ngl_node *bin_scene = ngl_node_deserialize_binary(bin, size);
+    ngli_assert(bin_scene);
+    char *bin_str = ngl_node_serialize(bin_scene);
+    ngli_assert(bin_str && !strcmp(ref, bin_str));
+
+    /* Truncated binary input must be rejected without being over-read */
+    const int truncated_sizes[] = {0, NGLI_SERIALIZE_BIN_HEADER_SIZE - 1, NGLI_SERIALIZE_BIN_HEADER_SIZE, size - 1};
+    for (int i = 0; i < NGLI_ARRAY_NB(truncated_sizes); i++) {
+        const int truncated_size = truncated_sizes[i];
+        uint8_t *truncated = malloc(NGLI_MAX(truncated_size, 1));
+        ngli_assert(truncated);
+        memcpy(truncated, bin, truncated_size);
+        struct ngl_node *node = ngl_node_deserialize_binary(truncated, truncated_size);
+        ngli_assert(!node);
+        free(truncated);
+    }
+
+    /* Binary input is not accepted by the string entry point */
+    ngli_assert(!ngl_node_deserialize((const char *)bin));
+
+    free(bin_str);
+    free(bin);
+    free(text_str);
+    free(ref);
+    ngl_node_unrefp(&bin_scene);
+    ngl_node_unrefp(&text_scene);
+    ngl_node_unrefp(&scene);
+
+    return 0;
+}
@@ -24,6 +24,7 @@
 #include "log.h"
 #include "utils.h"
 #include "format.h"
+#include "gctx.h"
 #include "glincludes.h"
 #include "glcontext.h"
 #include "nodes.h"
@@ -252,6 +253,8 @@ static int texture_init_fields(struct texture *s)
     struct glcontext *gl = ctx->glcontext;
     const struct texture_params *params = &s->params;
 
+    s->barriers = GL_TEXTURE_UPDATE_BARRIER_BIT | GL_FRAMEBUFFER_BARRIER_BIT;
+
     if (params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY) {
         s->target = GL_RENDERBUFFER;
         int ret = ngli_format_get_gl_renderbuffer_format(gl, params->format, &s->format);
@@ -329,6 +332,7 @@ int ngli_texture_init(struct texture *s,
     } else {
         ngli_glGenTextures(gl, 1, &s->id);
         ngli_glBindTexture(gl, s->target, s->id);
+        ngli_gctx_invalidate_active_texture(ctx);
         int mipmap_filter = params->mipmap_filter;
         if (mipmap_filter &&
             !(gl->features & NGLI_FEATURE_TEXTURE_NPOT) &&
@@ -428,7 +432,9 @@ int ngli_texture_upload(struct texture *s, const uint8_t *data, int linesize)
      * buffers) cannot update their content with this function */
     ngli_assert(!s->external_storage && !(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY));
 
+    ngli_gctx_flush_memory_barriers(ctx);
     ngli_glBindTexture(gl, s->target, s->id);
+    ngli_gctx_invalidate_active_texture(ctx);
     if (data) {
         texture_set_sub_image(s, data, linesize);
         if (ngli_texture_has_mipmap(s))
@@ -448,6 +454,7 @@ int ngli_texture_generate_mipmap(struct texture *s)
     ngli_assert(!(params->usage & NGLI_TEXTURE_USAGE_ATTACHMENT_ONLY));
 
     ngli_glBindTexture(gl, s->target, s->id);
+    ngli_gctx_invalidate_active_texture(ctx);
     ngli_glGenerateMipmap(gl, s->target);
     return 0;
 }
@@ -460,6 +467,9 @@ void ngli_texture_reset(struct texture *s)
 
     struct glcontext *gl = ctx->glcontext;
 
+    if (s->target != GL_RENDERBUFFER)
+        ngli_gctx_invalidate_texture(ctx, s->id);
+
     if (!s->wrapped) {
         if (s->target == GL_RENDERBUFFER)
             ngli_glDeleteRenderbuffers(gl, 1, &s->id);
@@ -469,3 +479,102 @@ void ngli_texture_reset(struct texture *s)
 
     memset(s, 0, sizeof(*s));
 }
+
+static int params_match(const struct texture_params *a, const struct texture_params *b)
+{
+    return a->dimensions       == b->dimensions       &&
+           a->format           == b->format           &&
+           a->width            == b->width            &&
+           a->height           == b->height           &&
+           a->depth            == b->depth            &&
+           a->samples          == b->samples          &&
+           a->min_filter       == b->min_filter       &&
+           a->mag_filter       == b->mag_filter       &&
+           a->mipmap_filter    == b->mipmap_filter    &&
+           a->wrap_s           == b->wrap_s           &&
+           a->wrap_t           == b->wrap_t           &&
+           a->wrap_r           == b->wrap_r           &&
+           a->access           == b->access           &&
+           a->immutable        == b->immutable        &&
+           a->usage            == b->usage            &&
+           a->external_storage == b->external_storage &&
+           a->external_oes     == b->external_oes     &&
+           a->rectangle        == b->rectangle        &&
+           a->cubemap          == b->cubemap;
+}
+
+/* Approximation of the storage size, mipmap levels excluded */
+static int64_t get_storage_size(const struct texture *s)
+{
+    const struct texture_params *params = &s->params;
+    return (int64_t)params->width * params->height *
+           NGLI_MAX(params->depth, 1) * (params->cubemap ? 6 : 1) *
+           NGLI_MAX(params->samples, 1) * s->bytes_per_pixel;
+}
+
+static void remove_pooled_texture(struct darray *pool, int index)
+{
+    struct texture *textures = ngli_darray_data(pool);
+    const int nb_textures = ngli_darray_count(pool);
+    memmove(&textures[index], &textures[index + 1], (nb_textures - index - 1) * sizeof(*textures));
+    ngli_darray_pop(pool);
+}
+
+int ngli_texture_init_pooled(struct texture *s,
+                             struct ngl_ctx *ctx,
+                             const struct texture_params *params)
+{
+    struct darray *pool = &ctx->texture_pool;
+    struct texture *textures = ngli_darray_data(pool);
+    for (int i = 0; i < ngli_darray_count(pool); i++) {
+        if (!params_match(&textures[i].params, params))
+            continue;
+        *s = textures[i];
+        remove_pooled_texture(pool, i);
+        return 0;
+    }
+
+    return ngli_texture_init(s, ctx, params);
+}
+
+void ngli_texture_reset_pooled(struct texture *s)
+{
+    struct ngl_ctx *ctx = s->ctx;
+    if (!ctx)
+        return;
+
+    const int64_t size = get_storage_size(s);
+    if (s->wrapped || s->external_storage || size > NGLI_TEXTURE_POOL_MAX_BYTES) {
+        ngli_texture_reset(s);
+        return;
+    }
+
+    /* Evict the oldest entries until the released texture fits in the pool */
+    struct darray *pool = &ctx->texture_pool;
+    int64_t pool_size = size;
+    struct texture *textures = ngli_darray_data(pool);
+    for (int i = 0; i < ngli_darray_count(pool); i++)
+        pool_size += get_storage_size(&textures[i]);
+    while (ngli_darray_count(pool) &&
+           (ngli_darray_count(pool) >= NGLI_TEXTURE_POOL_SIZE ||
+            pool_size > NGLI_TEXTURE_POOL_MAX_BYTES)) {
+        textures = ngli_darray_data(pool);
+        pool_size -= get_storage_size(&textures[0]);
+        ngli_texture_reset(&textures[0]);
+        remove_pooled_texture(pool, 0);
+    }
+
+    if (!ngli_darray_push(pool, s)) {
+        ngli_texture_reset(s);
+        return;
+    }
+
+    memset(s, 0, sizeof(*s));
+}
+
+void ngli_texture_pool_flush(struct ngl_ctx *ctx)
+{
+    struct texture *texture;
+    while ((texture = ngli_darray_pop(&ctx->texture_pool)))
+        ngli_texture_reset(texture);
+}
@@ -112,6 +112,9 @@ struct texture {
     GLint format;
     GLint internal_format;
     GLenum format_type;
+
+    int mipmap_dirty;  // mip levels must be regenerated before sampling
+    GLbitfield barriers; // memory barriers required by the consumers of the texture after a shader wrote to it
 };
 
 int ngli_texture_init(struct texture *s,
@@ -134,4 +137,21 @@ int ngli_texture_generate_mipmap(struct texture *s);
 
 void ngli_texture_reset(struct texture *s);
 
+/*
+ * Pooled variants of ngli_texture_init() and ngli_texture_reset(): released
+ * textures are kept in a per-context pool and handed back to the next
+ * request with identical parameters. The pool holds at most
+ * NGLI_TEXTURE_POOL_SIZE entries and NGLI_TEXTURE_POOL_MAX_BYTES of storage,
+ * the oldest entries being evicted first. It is flushed when the scene is
+ * replaced. The content of a texture coming from the pool is undefined.
+ */
+#define NGLI_TEXTURE_POOL_SIZE      16
+#define NGLI_TEXTURE_POOL_MAX_BYTES (128 << 20)
+
+int ngli_texture_init_pooled(struct texture *s,
+                             struct ngl_ctx *ctx,
+                             const struct texture_params *params);
+void ngli_texture_reset_pooled(struct texture *s);
+void ngli_texture_pool_flush(struct ngl_ctx *ctx);
+
 #endif
@@ -68,7 +68,19 @@ void ngli_transform_draw(struct ngl_node *node)
      * underlying matrix stack buffer */
     const float *prev_matrix = next_matrix - 4 * 4;
 
-    ngli_mat4_mul(next_matrix, prev_matrix, s->matrix);
+    /* Static hierarchies draw with the same parent and local matrices frame
+     * after frame: only re-compose the modelview matrix when one of them
+     * changed (both can be altered by other nodes or live changes, so they
+     * are compared by value) */
+    if (!s->modelview_valid ||
+        memcmp(s->parent_matrix, prev_matrix, sizeof(s->parent_matrix)) ||
+        memcmp(s->local_matrix, s->matrix, sizeof(s->local_matrix))) {
+        memcpy(s->parent_matrix, prev_matrix, sizeof(s->parent_matrix));
+        memcpy(s->local_matrix, s->matrix, sizeof(s->local_matrix));
+        ngli_mat4_mul(s->modelview_matrix, prev_matrix, s->matrix);
+        s->modelview_valid = 1;
+    }
+    memcpy(next_matrix, s->modelview_matrix, sizeof(s->modelview_matrix));
     ngli_node_draw(child);
     ngli_darray_pop(&ctx->modelview_matrix_stack);
 }
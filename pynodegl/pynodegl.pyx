@@ -44,7 +44,9 @@ cdef extern from "nodegl.h":
     int ngl_node_param_set(ngl_node *node, const char *key, ...)
     char *ngl_node_dot(const ngl_node *node)
     char *ngl_node_serialize(const ngl_node *node)
+    void *ngl_node_serialize_binary(const ngl_node *node, int *sizep)
     ngl_node *ngl_node_deserialize(const char *s)
+    ngl_node *ngl_node_deserialize_binary(const void *data, int size)
 
     int ngl_anim_evaluate(ngl_node *anim, void *dst, double t)
 
@@ -76,11 +78,14 @@ cdef extern from "nodegl.h":
         int  set_surface_pts
         float clear_color[4]
         uint8_t *capture_buffer
+        int  capture_latency
 
     ngl_ctx *ngl_create()
     int ngl_configure(ngl_ctx *s, ngl_config *config)
     int ngl_set_scene(ngl_ctx *s, ngl_node *scene)
     int ngl_draw(ngl_ctx *s, double t) nogil
+    int ngl_draw_async(ngl_ctx *s, double t) nogil
+    int ngl_wait(ngl_ctx *s) nogil
     char *ngl_dot(ngl_ctx *s, double t) nogil
     void ngl_freep(ngl_ctx **ss)
 
@@ -192,6 +197,7 @@ cdef class Viewer:
         self.capture_buffer = kwargs.get('capture_buffer')
         if self.capture_buffer is not None:
             config.capture_buffer = self.capture_buffer
+        config.capture_latency = kwargs.get('capture_latency', 0)
         return ngl_configure(self.ctx, &config)
 
     def set_scene(self, _Node scene):
@@ -203,10 +209,28 @@ cdef class Viewer:
         ngl_node_unrefp(&scene)
         return ret
 
+    def set_scene_from_binary(self, bytes data):
+        cdef ngl_node *scene = ngl_node_deserialize_binary(<const char *>data, len(data))
+        ret = ngl_set_scene(self.ctx, scene)
+        ngl_node_unrefp(&scene)
+        return ret
+
     def draw(self, double t):
         with nogil:
             ngl_draw(self.ctx, t)
 
+    def draw_async(self, double t):
+        cdef int ret
+        with nogil:
+            ret = ngl_draw_async(self.ctx, t)
+        return ret
+
+    def wait(self):
+        cdef int ret
+        with nogil:
+            ret = ngl_wait(self.ctx)
+        return ret
+
     def dot(self, double t):
         cdef char *s;
         with nogil:
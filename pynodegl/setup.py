@@ -192,6 +192,17 @@ cdef class _Node:
     def serialize(self):
         return _ret_pystr(ngl_node_serialize(self.ctx))
 
+    def serialize_binary(self):
+        cdef int size = 0
+        cdef void *data = ngl_node_serialize_binary(self.ctx, &size)
+        if data == NULL:
+            return None
+        try:
+            data_bytes = (<char *>data)[:size]
+        finally:
+            free(data)
+        return data_bytes
+
     def dot(self):
         return _ret_pystr(ngl_node_dot(self.ctx))
 